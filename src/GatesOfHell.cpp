@@ -41,6 +41,9 @@
 #include "kernel/service/MemoryService.h"
 #include "kernel/service/SchedulerService.h"
 #include "kernel/memory/MemoryStatusNode.h"
+#include "kernel/interrupt/InterruptStatisticsNode.h"
+#include "kernel/interrupt/InterruptAffinityNode.h"
+#include "kernel/system/LockStatisticsNode.h"
 #include "device/power/apm/ApmMachine.h"
 #include "kernel/service/PowerManagementService.h"
 #include "device/pci/Pci.h"
@@ -366,6 +369,9 @@ void GatesOfHell::initializeFilesystem() {
     deviceDriver->addNode("/", new Filesystem::Memory::RandomNode());
     deviceDriver->addNode("/", new Filesystem::Memory::MountsNode());
     deviceDriver->addNode("/", new Kernel::MemoryStatusNode("memory"));
+    deviceDriver->addNode("/", new Kernel::InterruptStatisticsNode("interrupts"));
+    deviceDriver->addNode("/", new Kernel::InterruptAffinityNode("interrupt_affinity"));
+    deviceDriver->addNode("/", new Kernel::LockStatisticsNode("locks"));
 
     if (Kernel::Multiboot::isModuleLoaded("initrd")) {
         log.info("Initial ramdisk detected -> Mounting [%s]", "/initrd");
@@ -265,7 +265,7 @@ section .data
 
 ; Global descriptor table
 gdt:
-    times (6 * 8) db 0
+    times (7 * 8) db 0
 
 ; Global descriptor table for bios calls
 gdt_bios:
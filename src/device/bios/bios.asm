@@ -126,6 +126,10 @@ bios_call_3:
     add ecx, KERNEL_START
     mov ebp, ecx
 
+    ; The 16-bit code has loaded the flat data segment into FS -> Restore the per-core data segment (see Processor.h)
+    mov cx, 0x30
+    mov fs, cx
+
     ; Load page table of process and enable 4KB paging
     pop ecx
     mov cr3, ecx
@@ -111,4 +111,16 @@ Util::Array<Cpu::Configuration0> Cpu::readCr0() {
     return cr0.toArray();
 }
 
+uint64_t Cpu::readTimestampCounter() {
+    uint32_t low;
+    uint32_t high;
+
+    asm volatile (
+            "rdtsc"
+            : "=a"(low), "=d"(high)
+            );
+
+    return static_cast<uint64_t>(high) << 32 | low;
+}
+
 }
\ No newline at end of file
@@ -89,6 +89,14 @@ public:
 
     static Util::Array<Configuration0> readCr0();
 
+    /**
+     * Read the current value of the time stamp counter via rdtsc.
+     * The caller is responsible for checking, whether the TSC is available (see Util::Hardware::CpuId).
+     *
+     * @return The number of cycles since the last processor reset
+     */
+    static uint64_t readTimestampCounter();
+
     /**
      * Stop the processor via hlt instruction.
      */
@@ -27,6 +27,7 @@
 #include "lib/util/async/Atomic.h"
 #include "lib/util/collection/Array.h"
 #include "kernel/interrupt/InterruptVector.h"
+#include "kernel/system/Processor.h"
 
 namespace Kernel {
 struct InterruptFrame;
@@ -96,7 +97,7 @@ void Fpu::trigger(const Kernel::InterruptFrame &frame) {
     disarmFpuMonitor();
 
     auto &currentThread = schedulerService.getCurrentThread();
-    if (&currentThread == lastFpuThread) {
+    if (&currentThread == lastFpuThread.get()) {
         schedulerService.unlockScheduler();
         return;
     }
@@ -107,13 +108,15 @@ void Fpu::trigger(const Kernel::InterruptFrame &frame) {
         switchContextFpuOnly(currentThread);
     }
 
-    lastFpuThread = &currentThread;
+    lastFpuThread.set(&currentThread);
     schedulerService.unlockScheduler();
 }
 
 void Fpu::checkTerminatedThread(Kernel::Thread &thread) {
-    Util::Async::Atomic<uint32_t> wrapper(reinterpret_cast<uint32_t&>(lastFpuThread));
-    wrapper.compareAndSet(reinterpret_cast<uint32_t>(&thread), 0);
+    for (uint32_t i = 0; i < Kernel::Processor::getCount(); i++) {
+        Util::Async::Atomic<uint32_t> wrapper(reinterpret_cast<uint32_t&>(lastFpuThread.get(i)));
+        wrapper.compareAndSet(reinterpret_cast<uint32_t>(&thread), 0);
+    }
 }
 
 bool Fpu::isAvailable() {
@@ -155,11 +158,12 @@ bool Fpu::probeFpu() {
 }
 
 void Fpu::switchContext(Kernel::Thread &currentThread) {
-    if (lastFpuThread != nullptr) {
+    auto *lastThread = lastFpuThread.get();
+    if (lastThread != nullptr) {
         asm volatile (
                 "fxsave (%0)"
                 : :
-                "r"(lastFpuThread->getFpuContext())
+                "r"(lastThread->getFpuContext())
                 );
     }
 
@@ -171,11 +175,12 @@ void Fpu::switchContext(Kernel::Thread &currentThread) {
 }
 
 void Fpu::switchContextFpuOnly(Kernel::Thread &currentThread) {
-    if (lastFpuThread != nullptr) {
+    auto *lastThread = lastFpuThread.get();
+    if (lastThread != nullptr) {
         asm volatile (
                 "fnsave (%0)"
                 : :
-                "r"(lastFpuThread->getFpuContext())
+                "r"(lastThread->getFpuContext())
                 );
     }
 
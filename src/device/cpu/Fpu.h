@@ -21,6 +21,7 @@
 #include <cstdint>
 
 #include "kernel/interrupt/InterruptHandler.h"
+#include "kernel/system/PerCpu.h"
 
 namespace Kernel {
 class Logger;
@@ -76,7 +77,8 @@ private:
     static bool probeFpu();
 
     bool fxsrAvailable = isFxsrAvailable();
-    Kernel::Thread *lastFpuThread = nullptr;
+    // Each core has its own FPU, so the owner of the FPU state is tracked per core
+    Kernel::PerCpu<Kernel::Thread*> lastFpuThread;
 
     static Kernel::Logger log;
 };
@@ -30,6 +30,7 @@
 #include "lib/util/base/Constants.h"
 #include "kernel/paging/Paging.h"
 #include "kernel/system/TaskStateSegment.h"
+#include "kernel/system/Processor.h"
 #include "device/interrupt/apic/IoApic.h"
 #include "device/interrupt/apic/LocalApic.h"
 #include "device/interrupt/apic/LocalApicErrorHandler.h"
@@ -104,6 +105,7 @@ Apic* Apic::initialize() {
 
 void Apic::initializeCurrentLocalApic() {
     getCurrentLocalApic().initialize();
+    Kernel::Processor::registerCurrentProcessor();
 }
 
 LocalApic& Apic::getCurrentLocalApic() {
@@ -139,11 +141,69 @@ bool Apic::status(InterruptRequest interruptRequest) {
     return ioApic->status(gsi);
 }
 
+bool Apic::setAffinity(InterruptRequest interruptRequest, uint32_t cpuMask) {
+    auto gsi = getIrqOverride(interruptRequest);
+    if (ioApic->isNonMaskableInterrupt(gsi)) {
+        Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Apic: GSI is non maskable!");
+    }
+
+    // Remove all cores, which are not present or not online yet
+    uint32_t onlineMask = 0;
+    bool lowestPriorityPossible = true;
+    for (const auto *localApic : localApics.values()) {
+        const auto id = localApic->getCpuId();
+        if (id < 32 && (cpuMask & (1 << id)) != 0 && localApic->isInitialized()) {
+            onlineMask |= 1 << id;
+            lowestPriorityPossible &= localApic->supportsLogicalDestination();
+        }
+    }
+
+    if (onlineMask == 0) {
+        return false;
+    }
+
+    uint8_t firstId = 0;
+    while ((onlineMask & (1 << firstId)) == 0) {
+        firstId++;
+    }
+
+    if (onlineMask == static_cast<uint32_t>(1 << firstId) || !lowestPriorityPossible) {
+        ioApic->setDestination(gsi, firstId);
+    } else {
+        ioApic->setLowestPriorityDestination(gsi, static_cast<uint8_t>(onlineMask));
+    }
+
+    return true;
+}
+
+uint32_t Apic::getAffinity(InterruptRequest interruptRequest) {
+    auto gsi = getIrqOverride(interruptRequest);
+    auto entry = ioApic->readRedirectionTableEntry(gsi);
+    if (entry.destinationMode == IoApic::RedirectionTableEntry::DestinationMode::LOGICAL) {
+        return entry.destination;
+    }
+
+    return entry.destination < 32 ? 1 << entry.destination : 0;
+}
+
+bool Apic::supportsLowestPriorityDelivery() const {
+    for (const auto *localApic : localApics.values()) {
+        if (localApic->isInitialized() && !localApic->supportsLogicalDestination()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void Apic::sendEndOfInterrupt(Kernel::InterruptVector vector) {
     if (isLocalInterrupt(vector) && vector != Kernel::InterruptVector::LINT1) {
         // Excludes NMI, IPIs and SMIs are also excluded, but these don't have vector numbers,
         // so they won't reach this anyway.
         LocalApic::sendEndOfInterrupt();
+    } else if (isMessageSignaledInterrupt(vector)) {
+        // Message signaled interrupts bypass the I/O APIC and are always edge-triggered
+        LocalApic::sendEndOfInterrupt();
     } else if (isExternalInterrupt(vector)) {
         // Edge-triggered external interrupts have to be EOId in the local APIC,
         // level-triggered external interrupts can EOId in the local APIC if EOI-broadcasting is enabled,
@@ -158,6 +218,10 @@ bool Apic::isLocalInterrupt(Kernel::InterruptVector vector) const {
     return vector >= Kernel::InterruptVector::CMCI && vector <= Kernel::InterruptVector::ERROR;
 }
 
+bool Apic::isMessageSignaledInterrupt(Kernel::InterruptVector vector) {
+    return vector >= Kernel::InterruptVector::MESSAGE_SIGNALED_START && vector <= Kernel::InterruptVector::MESSAGE_SIGNALED_END;
+}
+
 bool Apic::isExternalInterrupt(Kernel::InterruptVector vector) const {
     // Remapping can be ignored here, as all GSIs are contiguous anyway
     return static_cast<Kernel::GlobalSystemInterrupt>(vector - 32) <= ioApic->getMaxGlobalSystemInterruptNumber();
@@ -452,13 +516,13 @@ Cpu::Descriptor *Apic::allocateApplicationProcessorGdt() {
     // Allocate memory for the GDT and TSS. This is never freed, as its used as long as the system runs.
     auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
 
-    auto *gdt = reinterpret_cast<uint16_t*>(memoryService.allocateLowerMemory(48));
+    auto *gdt = reinterpret_cast<uint16_t*>(memoryService.allocateLowerMemory(56));
 
     const uint32_t tssSize = sizeof(Kernel::TaskStateSegment);
     auto *tss = reinterpret_cast<void *>(memoryService.allocateLowerMemory(tssSize));
 
     // Zero everything
-    Util::Address<uint32_t>(gdt).setRange(0, 48);
+    Util::Address<uint32_t>(gdt).setRange(0, 56);
     Util::Address<uint32_t>(tss).setRange(0, tssSize);
 
     // Set up general GDT for the AP
@@ -474,9 +538,11 @@ Cpu::Descriptor *Apic::allocateApplicationProcessorGdt() {
     Kernel::System::createGlobalDescriptorTableEntry(gdt, 4, 0, 0xFFFFFFFF, 0xF2, 0xC);
     // TSS segment
     Kernel::System::createGlobalDescriptorTableEntry(gdt, 5, reinterpret_cast<uint32_t>(tss), tssSize, 0x89, 0x4);
+    // Per-core data segment (pointed to this core's data in Processor::registerCurrentProcessor())
+    Kernel::Processor::createLocalDataDescriptor(gdt, 0);
 
     return new Cpu::Descriptor {
-            .limit = 6 * 8,
+            .limit = 7 * 8,
             .address = reinterpret_cast<uint32_t>(gdt) // + Kernel::MemoryLayout::KERNEL_START
     };
 }
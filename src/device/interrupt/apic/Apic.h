@@ -104,6 +104,31 @@ public:
      */
     bool status(InterruptRequest interruptRequest);
 
+    /**
+     * Set the cores, which may receive an external interrupt.
+     * If the mask contains a single core, the interrupt is routed to it using fixed delivery.
+     * If it contains multiple cores, lowest priority delivery is used, if supported by all of them.
+     * Otherwise, the interrupt is routed to the first core in the mask.
+     *
+     * @param interruptRequest The interrupt
+     * @param cpuMask A bitmask, containing one bit per local APIC id (only ids 0 to 31 can be addressed)
+     * @return true, if the given mask contains at least one online core
+     */
+    bool setAffinity(InterruptRequest interruptRequest, uint32_t cpuMask);
+
+    /**
+     * Get the cores, which may receive an external interrupt.
+     *
+     * @param interruptRequest The interrupt
+     * @return A bitmask, containing one bit per local APIC id
+     */
+    uint32_t getAffinity(InterruptRequest interruptRequest);
+
+    /**
+     * Check, whether lowest priority delivery can be used for all online cores.
+     */
+    [[nodiscard]] bool supportsLowestPriorityDelivery() const;
+
     /**
      * Signal the completion of an interrupt to the current CPU, local or external.
      */
@@ -119,6 +144,11 @@ public:
      */
     bool isExternalInterrupt(Kernel::InterruptVector vector) const;
 
+    /**
+     * Check if an interrupt vector belongs to a message signaled interrupt (MSI/MSI-X).
+     */
+    static bool isMessageSignaledInterrupt(Kernel::InterruptVector vector);
+
     /**
      * Check if this core's local APIC timer has been initialized.
      */
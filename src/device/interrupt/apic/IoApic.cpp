@@ -92,6 +92,22 @@ bool IoApic::status(Kernel::GlobalSystemInterrupt gsi) {
     return entry.isMasked;
 }
 
+void IoApic::setDestination(Kernel::GlobalSystemInterrupt gsi, uint8_t apicId) {
+    auto entry = readRedirectionTableEntry(gsi);
+    entry.deliveryMode = RedirectionTableEntry::DeliveryMode::FIXED;
+    entry.destinationMode = RedirectionTableEntry::DestinationMode::PHYSICAL;
+    entry.destination = apicId;
+    writeRedirectionTableEntry(gsi, entry);
+}
+
+void IoApic::setLowestPriorityDestination(Kernel::GlobalSystemInterrupt gsi, uint8_t logicalDestination) {
+    auto entry = readRedirectionTableEntry(gsi);
+    entry.deliveryMode = RedirectionTableEntry::DeliveryMode::LOWPRIO;
+    entry.destinationMode = RedirectionTableEntry::DestinationMode::LOGICAL;
+    entry.destination = logicalDestination;
+    writeRedirectionTableEntry(gsi, entry);
+}
+
 void IoApic::initializeRedirectionTable() {
     RedirectionTableEntry entry{};
     entry.deliveryMode = RedirectionTableEntry::DeliveryMode::FIXED;
@@ -180,6 +180,23 @@ public:
      */
     bool status(Kernel::GlobalSystemInterrupt gsi);
 
+    /**
+     * Route an interrupt to a single local APIC (physical destination mode, fixed delivery).
+     *
+     * @param gsi The interrupt input
+     * @param apicId The id of the target local APIC
+     */
+    void setDestination(Kernel::GlobalSystemInterrupt gsi, uint8_t apicId);
+
+    /**
+     * Route an interrupt to the local APIC with the lowest priority in a set of local APICs
+     * (logical destination mode in flat model, lowest priority delivery).
+     *
+     * @param gsi The interrupt input
+     * @param logicalDestination A bitmask, containing one bit per local APIC
+     */
+    void setLowestPriorityDestination(Kernel::GlobalSystemInterrupt gsi, uint8_t logicalDestination);
+
     /**
      * Initialize a this I/O APIC's interrupt redirection table.
      *
@@ -99,9 +99,18 @@ void LocalApic::initialize() {
     // by sending the INIT-level-deassert IPI to all APICs.
     synchronizeArbitrationIds();
 
+    // Use the flat model for logical destinations (IA-32, sec. 3.11.6.2.2), where each local APIC is addressed by a single bit.
+    // This is required for the I/O APIC to use lowest priority delivery among a set of cores.
+    writeDoubleWord(DFR, 0xffffffff);
+    if (supportsLogicalDestination()) {
+        writeDoubleWord(LDR, (1 << cpuId) << 24);
+    }
+
     // Allow all interrupts to be forwarded to the CPU by setting the Task-Priority Class and Sub Class thresholds to 0
     // This should be 0 after power-up, but it doesn't hurt to set it again
     writeDoubleWord(TPR, 0);
+
+    initialized = true;
 }
 
 void LocalApic::enableXApicMode(uint32_t baseAddress) {
@@ -288,6 +297,14 @@ uint8_t LocalApic::getCpuId() const {
     return cpuId;
 }
 
+bool LocalApic::isInitialized() const {
+    return initialized;
+}
+
+bool LocalApic::supportsLogicalDestination() const {
+    return cpuId <= MAX_FLAT_LOGICAL_ID;
+}
+
 LocalApic::BaseModelSpecificRegisterEntry::BaseModelSpecificRegisterEntry(uint64_t registerValue) :
         isBootstrapProcessor(registerValue & (1 << 8)),
         isX2Apic(registerValue & (1 << 10)),
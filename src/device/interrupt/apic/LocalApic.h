@@ -85,7 +85,8 @@ public:
         };
         enum class TimerMode : uint8_t {
             ONESHOT = 0,
-            PERIODIC = 1
+            PERIODIC = 1,
+            TSC_DEADLINE = 2
         };
 
         Kernel::InterruptVector vector;
@@ -442,10 +443,24 @@ public:
 
     [[nodiscard]] uint8_t getCpuId() const;
 
+    /**
+     * Check, whether this local APIC has been initialized (i.e. its core is online and able to receive interrupts).
+     */
+    [[nodiscard]] bool isInitialized() const;
+
+    /**
+     * Check, whether interrupts can be sent in logical destination mode (flat model) to this local APIC.
+     * The flat model supports only APIC IDs 0 to 7, since each local APIC is represented by a single bit.
+     */
+    [[nodiscard]] bool supportsLogicalDestination() const;
+
+    static const constexpr uint8_t MAX_FLAT_LOGICAL_ID = 7;
+
 private:
 
     uint8_t cpuId; // The CPU core this instance belongs to, LocalApic::getId() only returns the current AP's id!
     Util::ArrayList<NmiSource> nmiSources;
+    bool initialized = false;
 
     static uint32_t mmioAddress; // The virtual address used to access registers in xApic mode.
 
@@ -21,6 +21,10 @@
 #include "kernel/log/Logger.h"
 #include "lib/util/collection/ArrayList.h"
 #include "lib/util/collection/Iterator.h"
+#include "device/power/acpi/Acpi.h"
+#include "kernel/system/System.h"
+#include "kernel/service/MemoryService.h"
+#include "lib/util/hardware/Acpi.h"
 
 namespace Device {
 
@@ -28,6 +32,10 @@ const IoPort Pci::configAddressPort = IoPort(CONFIG_ADDRESS);
 const IoPort Pci::configDataPort = IoPort(CONFIG_DATA);
 Kernel::Logger Pci::log = Kernel::Logger::get("PCI");
 Util::ArrayList<PciDevice> Pci::devices = Util::ArrayList<PciDevice>();
+uint32_t Pci::ecamAddress = 0;
+uint8_t Pci::ecamStartBus = 0;
+uint8_t Pci::ecamEndBus = 0;
+volatile uint8_t *Pci::ecamBuses[256]{};
 
 void Pci::prepareRegister(uint8_t bus, uint8_t device, uint8_t function, uint8_t offset) {
     uint32_t address = 0x80000000 | (bus << 16) | (device << 11) | (function << 8) | (offset & 0xfc);
@@ -35,6 +43,11 @@ void Pci::prepareRegister(uint8_t bus, uint8_t device, uint8_t function, uint8_t
 }
 
 uint32_t Pci::readDoubleWord(uint8_t bus, uint8_t device, uint8_t function, uint8_t offset) {
+    auto *address = getEcamAddress(bus, device, function);
+    if (address != nullptr) {
+        return *reinterpret_cast<volatile uint32_t*>(address + (offset & 0xfc));
+    }
+
     prepareRegister(bus, device, function, offset);
     return configDataPort.readDoubleWord();
 }
@@ -48,32 +61,94 @@ uint8_t Pci::readByte(uint8_t bus, uint8_t device, uint8_t function, uint8_t off
 }
 
 void Pci::writeDoubleWord(uint8_t bus, uint8_t device, uint8_t function, uint8_t offset, uint32_t value) {
+    auto *address = getEcamAddress(bus, device, function);
+    if (address != nullptr) {
+        *reinterpret_cast<volatile uint32_t*>(address + (offset & 0xfc)) = value;
+        return;
+    }
+
     prepareRegister(bus, device, function, offset);
     configDataPort.writeDoubleWord(value);
 }
 
 void Pci::writeWord(uint8_t bus, uint8_t device, uint8_t function, uint8_t offset, uint16_t value) {
+    auto *address = getEcamAddress(bus, device, function);
+    if (address != nullptr) {
+        *reinterpret_cast<volatile uint16_t*>(address + (offset & 0xfe)) = value;
+        return;
+    }
+
     prepareRegister(bus, device, function, offset);
     configDataPort.writeWord(offset & 0x02, value);
 }
 
 void Pci::writeByte(uint8_t bus, uint8_t device, uint8_t function, uint8_t offset, uint8_t value) {
+    auto *address = getEcamAddress(bus, device, function);
+    if (address != nullptr) {
+        *(address + offset) = value;
+        return;
+    }
+
     prepareRegister(bus, device, function, offset);
     configDataPort.writeByte(offset & 0x03, value);
 }
 
+void Pci::initializeEcam() {
+    if (!Acpi::isAvailable() || !Acpi::hasTable("MCFG")) {
+        return;
+    }
+
+    const auto &mcfg = Acpi::getTable<Util::Hardware::Acpi::Mcfg>("MCFG");
+    auto count = (mcfg.header.length - sizeof(Util::Hardware::Acpi::Mcfg)) / sizeof(Util::Hardware::Acpi::ConfigurationSpaceAllocation);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const auto &allocation = mcfg.allocations[i];
+        // Only segment group 0 is reachable via I/O ports, so other segment groups are not supported
+        if (allocation.pciSegmentGroup != 0) {
+            continue;
+        }
+
+        if (allocation.baseAddress > 0xffffffff) {
+            log.warn("Configuration space is located above 4 GiB -> Using I/O ports");
+            return;
+        }
+
+        // The base address corresponds to bus 0, even if the allocation starts at a higher bus
+        ecamAddress = static_cast<uint32_t>(allocation.baseAddress);
+        ecamStartBus = allocation.startBus;
+        ecamEndBus = allocation.endBus;
+        log.info("Using memory mapped configuration space at [0x%08x] for buses [%u-%u]", ecamAddress, ecamStartBus, ecamEndBus);
+        return;
+    }
+}
+
+volatile uint8_t* Pci::getEcamAddress(uint8_t bus, uint8_t device, uint8_t function) {
+    if (ecamAddress == 0 || bus < ecamStartBus || bus > ecamEndBus) {
+        return nullptr;
+    }
+
+    if (ecamBuses[bus] == nullptr) {
+        auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
+        ecamBuses[bus] = static_cast<volatile uint8_t*>(memoryService.mapIO(ecamAddress + bus * ECAM_BUS_SIZE, ECAM_BUS_SIZE));
+    }
+
+    return ecamBuses[bus] + (device << 15) + (function << 12);
+}
+
 void Pci::scan() {
+    initializeEcam();
+
     // Check header type of host controller
     // If it is a multi-function device, there multiple host controllers available at bus 0, device 0, function 0-7
     // Otherwise, there is only one host controller at bus 0, device 0, function 0
     auto headerType = readByte(0, 0, 0, HEADER_TYPE);
-    if ((headerType & 0x80) == 0) {
+    if ((headerType & HEADER_TYPE_MULTIFUNCTION_BIT) == 0) {
         scanBus(0);
     } else {
         for (uint8_t i = 0; i < MAX_FUNCTIONS_PER_DEVICE; i++) {
             auto vendorId = readWord(0, 0, i, VENDOR_ID);
-            if (vendorId != INVALID_VENDOR) {
-                break;
+            if (vendorId == INVALID_VENDOR) {
+                continue;
             }
 
             scanBus(i);
@@ -86,13 +161,17 @@ PciDevice Pci::readDevice(uint8_t bus, uint8_t device, uint8_t function) {
 }
 
 void Pci::checkFunction(uint8_t bus, uint8_t device, uint8_t function) {
-    auto baseClass = readByte(bus, device, function, CLASS);
-    auto subClass = readByte(bus, device, function, SUBCLASS);
+    // Class and subclass share one double word, so read them with a single access
+    auto classCode = readDoubleWord(bus, device, function, REVISION);
+    auto baseClass = static_cast<uint8_t>(classCode >> 24);
+    auto subClass = static_cast<uint8_t>(classCode >> 16);
 
     if (baseClass == BRIDGE && subClass == PCI_TO_PCI) {
         log.info("Found PCI-to-PCI bridge on bus [%u]", bus);
         uint8_t secondaryBus = readByte(bus, device, function, SECONDARY_BUS);
-        scanBus(secondaryBus);
+
+        // Behind PCI Express root and downstream ports, there is a point-to-point link with only device 0
+        scanBus(secondaryBus, isPciExpressPort(bus, device, function) ? 1 : MAX_DEVICES_PER_BUS);
     } else {
         auto pciDevice = readDevice(bus, device, function);
         log.info("Found PCI device [0x%04x:0x%04x] on bus [%u]", pciDevice.getVendorId(), pciDevice.getDeviceId(), bus);
@@ -101,6 +180,7 @@ void Pci::checkFunction(uint8_t bus, uint8_t device, uint8_t function) {
 }
 
 void Pci::checkDevice(uint8_t bus, uint8_t device) {
+    // Functions 1-7 can only exist, if function 0 exists and reports a multi-function device
     auto vendorId = readWord(bus, device, 0, VENDOR_ID);
     if (vendorId == INVALID_VENDOR) {
         return;
@@ -119,12 +199,24 @@ void Pci::checkDevice(uint8_t bus, uint8_t device) {
     }
 }
 
-void Pci::scanBus(uint8_t bus) {
-    for (uint8_t i = 0; i < MAX_DEVICES_PER_BUS; i++) {
+void Pci::scanBus(uint8_t bus, uint8_t deviceCount) {
+    for (uint8_t i = 0; i < deviceCount; i++) {
         checkDevice(bus, i);
     }
 }
 
+bool Pci::isPciExpressPort(uint8_t bus, uint8_t device, uint8_t function) {
+    auto pciDevice = PciDevice(bus, device, function);
+    auto capability = pciDevice.findCapability(PCI_EXPRESS);
+    if (capability == 0) {
+        return false;
+    }
+
+    // Device/Port type is located in bits 4-7 of the PCI Express capabilities register
+    auto portType = (pciDevice.readWord(capability + 2) >> 4) & 0x0f;
+    return portType == PCI_EXPRESS_ROOT_PORT || portType == PCI_EXPRESS_DOWNSTREAM_PORT;
+}
+
 Util::Array<PciDevice> Pci::search(uint16_t vendorId) {
     Util::ArrayList<PciDevice> found = Util::ArrayList<PciDevice>();
     for (const auto &device : devices) {
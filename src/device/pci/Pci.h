@@ -100,6 +100,25 @@ public:
         DETECTED_PARITY_ERROR = 0x8000
     };
 
+    enum Capability : uint8_t {
+        POWER_MANAGEMENT = 0x01,
+        AGP = 0x02,
+        VITAL_PRODUCT_DATA = 0x03,
+        SLOT_IDENTIFICATION = 0x04,
+        MSI = 0x05,
+        HOT_SWAP = 0x06,
+        PCI_X = 0x07,
+        HYPER_TRANSPORT = 0x08,
+        VENDOR_SPECIFIC = 0x09,
+        DEBUG_PORT = 0x0a,
+        HOT_PLUG = 0x0c,
+        BRIDGE_SUBSYSTEM_VENDOR_ID = 0x0d,
+        PCI_EXPRESS = 0x10,
+        MSI_X = 0x11,
+        SATA = 0x12,
+        ADVANCED_FEATURES = 0x13
+    };
+
     enum Class : uint8_t {
         UNCLASSIFIED = 0x00,
         MASS_STORAGE = 0x01,
@@ -197,10 +216,29 @@ private:
 
     static void checkDevice(uint8_t bus, uint8_t device);
 
-    static void scanBus(uint8_t bus);
+    static void scanBus(uint8_t bus, uint8_t deviceCount = MAX_DEVICES_PER_BUS);
+
+    /**
+     * Search the ACPI MCFG table for the configuration space of segment group 0.
+     * If found, all buses covered by it are accessed via memory mapped configuration space instead of I/O ports.
+     */
+    static void initializeEcam();
+
+    /**
+     * Get the mapped configuration space of a single function, or nullptr if it is only accessible via I/O ports.
+     * Buses are mapped on first access, so that only present buses occupy virtual address space.
+     */
+    static volatile uint8_t* getEcamAddress(uint8_t bus, uint8_t device, uint8_t function);
+
+    static bool isPciExpressPort(uint8_t bus, uint8_t device, uint8_t function);
 
     static const IoPort configAddressPort;
     static const IoPort configDataPort;
+
+    static uint32_t ecamAddress;
+    static uint8_t ecamStartBus;
+    static uint8_t ecamEndBus;
+    static volatile uint8_t *ecamBuses[256];
     
     static Kernel::Logger log;
     static Util::ArrayList<PciDevice> devices;
@@ -212,6 +250,9 @@ private:
     static const constexpr uint8_t MAX_FUNCTIONS_PER_DEVICE = 8;
     static const constexpr uint16_t INVALID_VENDOR = 0xFFFF;
     static const constexpr uint8_t HEADER_TYPE_MULTIFUNCTION_BIT = 0x80;
+    static const constexpr uint32_t ECAM_BUS_SIZE = 1024 * 1024;
+    static const constexpr uint8_t PCI_EXPRESS_ROOT_PORT = 0x04;
+    static const constexpr uint8_t PCI_EXPRESS_DOWNSTREAM_PORT = 0x06;
 };
 
 }
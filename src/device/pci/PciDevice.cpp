@@ -19,6 +19,10 @@
 
 #include "device/pci/Pci.h"
 #include "lib/util/collection/ArrayList.h"
+#include "kernel/system/System.h"
+#include "kernel/service/MemoryService.h"
+#include "lib/util/base/Constants.h"
+#include "lib/util/base/Exception.h"
 
 namespace Device {
 enum InterruptRequest : uint8_t;
@@ -111,7 +115,7 @@ Util::Array<uint8_t> PciDevice::readCapabilities() const {
 
     while (currentRegister != 0x00) {
         capabilities.add(readByte(currentRegister));
-        currentRegister = readByte(currentRegister + 1);
+        currentRegister = readByte(currentRegister + 1) & 0xfc;
     }
 
     return capabilities.toArray();
@@ -153,4 +157,139 @@ Device::InterruptRequest PciDevice::getInterruptLine() const {
     return interruptLine;
 }
 
+uint8_t PciDevice::findCapability(Pci::Capability capability) const {
+    if (!readStatus().contains(Pci::CAPABILITIES_LIST)) {
+        return 0;
+    }
+
+    // The lowest two bits of each pointer are reserved
+    auto currentRegister = capabilitiesPointer & 0xfc;
+    while (currentRegister != 0x00) {
+        if (readByte(currentRegister) == capability) {
+            return currentRegister;
+        }
+
+        currentRegister = readByte(currentRegister + 1) & 0xfc;
+    }
+
+    return 0;
+}
+
+bool PciDevice::supportsMsi() const {
+    return findCapability(Pci::MSI) != 0;
+}
+
+uint8_t PciDevice::getMsiVectorCount() const {
+    auto capability = findCapability(Pci::MSI);
+    if (capability == 0) {
+        return 0;
+    }
+
+    auto control = readWord(capability + 2);
+    return 1 << ((control >> 1) & 0x07);
+}
+
+void PciDevice::enableMsi(Kernel::InterruptVector baseVector, uint8_t count, uint8_t destination) const {
+    auto capability = findCapability(Pci::MSI);
+    if (capability == 0) {
+        Util::Exception::throwException(Util::Exception::UNSUPPORTED_OPERATION, "PciDevice: MSI is not supported!");
+    }
+
+    uint8_t multipleMessageEnable = 0;
+    while ((1 << multipleMessageEnable) < count) {
+        multipleMessageEnable++;
+    }
+
+    auto control = readWord(capability + 2);
+    writeDoubleWord(capability + 4, getMessageAddress(destination));
+    if ((control & MSI_CONTROL_64_BIT) != 0) {
+        writeDoubleWord(capability + 8, 0);
+        writeWord(capability + 12, baseVector); // Fixed delivery, edge triggered
+    } else {
+        writeWord(capability + 8, baseVector); // Fixed delivery, edge triggered
+    }
+
+    control = (control & ~(0x07 << 4)) | (multipleMessageEnable << 4) | MSI_CONTROL_ENABLE;
+    writeWord(capability + 2, control);
+    writeCommand(Util::Array<Pci::Command>({Pci::INTERRUPT_DISABLE}));
+}
+
+void PciDevice::disableMsi() const {
+    auto capability = findCapability(Pci::MSI);
+    if (capability == 0) {
+        return;
+    }
+
+    writeWord(capability + 2, readWord(capability + 2) & ~MSI_CONTROL_ENABLE);
+    writeWord(Pci::COMMAND, readWord(Pci::COMMAND) & ~Pci::INTERRUPT_DISABLE);
+}
+
+bool PciDevice::supportsMsiX() const {
+    return findCapability(Pci::MSI_X) != 0;
+}
+
+uint16_t PciDevice::getMsiXTableSize() const {
+    auto capability = findCapability(Pci::MSI_X);
+    if (capability == 0) {
+        return 0;
+    }
+
+    return (readWord(capability + 2) & 0x07ff) + 1;
+}
+
+void PciDevice::enableMsiX(const Util::Array<Kernel::InterruptVector> &vectors, uint8_t destination) const {
+    auto capability = findCapability(Pci::MSI_X);
+    if (capability == 0) {
+        Util::Exception::throwException(Util::Exception::UNSUPPORTED_OPERATION, "PciDevice: MSI-X is not supported!");
+    }
+
+    auto tableSize = getMsiXTableSize();
+    if (vectors.length() > tableSize) {
+        Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "PciDevice: Too many MSI-X vectors!");
+    }
+
+    // Mask all vectors, while the table is being configured
+    auto control = readWord(capability + 2);
+    writeWord(capability + 2, control | MSI_X_CONTROL_FUNCTION_MASK | MSI_X_CONTROL_ENABLE);
+
+    // The table resides in memory space, pointed to by one of the BARs
+    auto tableInfo = readDoubleWord(capability + 4);
+    auto bar = readDoubleWord(Pci::BASE_ADDRESS_0 + (tableInfo & 0x07) * 4) & 0xfffffff0;
+    auto tableAddress = bar + (tableInfo & 0xfffffff8);
+    auto pageOffset = tableAddress % Util::PAGESIZE;
+
+    auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
+    auto *table = reinterpret_cast<volatile uint32_t*>(reinterpret_cast<uint32_t>(memoryService.mapIO(tableAddress - pageOffset, pageOffset + tableSize * 16)) + pageOffset);
+
+    for (uint32_t i = 0; i < tableSize; i++) {
+        auto *entry = table + i * 4;
+        if (i < vectors.length()) {
+            entry[0] = getMessageAddress(destination);
+            entry[1] = 0;
+            entry[2] = vectors[i];
+            entry[3] = entry[3] & ~MSI_X_ENTRY_MASKED;
+        } else {
+            entry[3] = entry[3] | MSI_X_ENTRY_MASKED;
+        }
+    }
+
+    writeCommand(Util::Array<Pci::Command>({Pci::INTERRUPT_DISABLE}));
+    writeWord(capability + 2, (control & ~MSI_X_CONTROL_FUNCTION_MASK) | MSI_X_CONTROL_ENABLE);
+}
+
+void PciDevice::disableMsiX() const {
+    auto capability = findCapability(Pci::MSI_X);
+    if (capability == 0) {
+        return;
+    }
+
+    writeWord(capability + 2, readWord(capability + 2) & ~MSI_X_CONTROL_ENABLE);
+    writeWord(Pci::COMMAND, readWord(Pci::COMMAND) & ~Pci::INTERRUPT_DISABLE);
+}
+
+uint32_t PciDevice::getMessageAddress(uint8_t destination) {
+    // Physical destination mode, no redirection hint
+    return MSI_ADDRESS_BASE | (static_cast<uint32_t>(destination) << 12);
+}
+
 }
\ No newline at end of file
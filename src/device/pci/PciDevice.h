@@ -23,6 +23,10 @@
 #include "Pci.h"
 #include "lib/util/collection/Array.h"
 
+namespace Kernel {
+enum InterruptVector : uint8_t;
+}  // namespace Kernel
+
 namespace Device {
 enum InterruptRequest : uint8_t;
 
@@ -96,8 +100,60 @@ public:
 
     [[nodiscard]] Device::InterruptRequest getInterruptLine() const;
 
+    /**
+     * Search the capability list for a capability.
+     *
+     * @param capability The capability id
+     * @return The configuration space offset of the capability structure, or 0 if the device does not support it
+     */
+    [[nodiscard]] uint8_t findCapability(Pci::Capability capability) const;
+
+    [[nodiscard]] bool supportsMsi() const;
+
+    /**
+     * Get the number of message signaled interrupt vectors, this device requests (Multiple Message Capable).
+     */
+    [[nodiscard]] uint8_t getMsiVectorCount() const;
+
+    /**
+     * Enable message signaled interrupts and disable the legacy INTx line.
+     * The device uses the vectors baseVector to baseVector + count - 1, which must be an aligned block.
+     *
+     * @param baseVector The first interrupt vector, allocated via the InterruptService
+     * @param count The number of vectors (power of two, at most getMsiVectorCount())
+     * @param destination The id of the local APIC, which should receive the interrupts
+     */
+    void enableMsi(Kernel::InterruptVector baseVector, uint8_t count, uint8_t destination) const;
+
+    void disableMsi() const;
+
+    [[nodiscard]] bool supportsMsiX() const;
+
+    [[nodiscard]] uint16_t getMsiXTableSize() const;
+
+    /**
+     * Enable MSI-X and disable the legacy INTx line.
+     * Table entry i is configured to send vectors[i], all other entries stay masked.
+     *
+     * @param vectors The interrupt vectors, allocated via the InterruptService
+     * @param destination The id of the local APIC, which should receive the interrupts
+     */
+    void enableMsiX(const Util::Array<Kernel::InterruptVector> &vectors, uint8_t destination) const;
+
+    void disableMsiX() const;
+
+    static const constexpr uint32_t MSI_ADDRESS_BASE = 0xfee00000;
+
 private:
 
+    static uint32_t getMessageAddress(uint8_t destination);
+
+    static const constexpr uint16_t MSI_CONTROL_ENABLE = 0x0001;
+    static const constexpr uint16_t MSI_CONTROL_64_BIT = 0x0080;
+    static const constexpr uint16_t MSI_X_CONTROL_FUNCTION_MASK = 0x4000;
+    static const constexpr uint16_t MSI_X_CONTROL_ENABLE = 0x8000;
+    static const constexpr uint32_t MSI_X_ENTRY_MASKED = 0x00000001;
+
     uint8_t bus{};
     uint8_t device{};
     uint8_t function{};
@@ -20,6 +20,8 @@
 #include "kernel/interrupt/InterruptVector.h"
 #include "lib/util/collection/ArrayList.h"
 #include "lib/util/collection/Iterator.h"
+#include "lib/util/async/Atomic.h"
+#include "device/cpu/Cpu.h"
 
 namespace Kernel {
     class Logger;
@@ -31,6 +33,8 @@ namespace Device::Storage {
     virtual_port_addr vpa[32]; //Virtual port addresses of each port
     uint32_t lba_capacity[32]; //LBA capacity of each port
     uint32_t sector_size[32]; //sector size of each port in bytes (512 or 4096)
+    port_command_state commandState[32]; //Command slot state of each port
+    bool completionInterrupts = false; //True, if the HBA signals command completions via its own MSI vector(s)
 
     char* strip_and_swap(char *str, int len){
         char *str2 = new char[len+1];
@@ -116,6 +120,43 @@ namespace Device::Storage {
 			    }
             }
 		}
+
+        enableMessageSignaledInterrupts(device);
+    }
+
+    void AhciController::enableMessageSignaledInterrupts(const PciDevice &device) {
+        auto &interruptService = Kernel::System::getService<Kernel::InterruptService>();
+        if (!interruptService.supportsMessageSignaledInterrupts() || !device.supportsMsi()) {
+            return;
+        }
+
+        // With multiple messages, the HBA uses vector n for port n (AHCI 1.3.1, section 10.6.2)
+        uint8_t requestedCount = 1;
+        while (requestedCount < device.getMsiVectorCount() && (hbaMem->pi >> requestedCount) != 0) {
+            requestedCount *= 2;
+        }
+
+        auto baseVector = interruptService.allocateMessageSignaledInterrupts(requestedCount);
+        if (baseVector == 0 && requestedCount > 1) {
+            requestedCount = 1;
+            baseVector = interruptService.allocateMessageSignaledInterrupts(requestedCount);
+        }
+
+        if (baseVector == 0) {
+            log.warn("No free interrupt vectors for MSI -> Using legacy interrupt line");
+            return;
+        }
+
+        device.enableMsi(baseVector, requestedCount, interruptService.getCpuId());
+        msiBaseVector = baseVector;
+        msiVectorCount = requestedCount;
+
+        // The HBA may fall back to a single message, if it cannot use all granted vectors
+        if (msiVectorCount > 1 && (hbaMem->ghc & HBA_GHC_MRSM)) {
+            log.warn("HBA reverted to single MSI message");
+        }
+
+        log.info("Using %u MSI vector(s), starting at [%u]", msiVectorCount, msiBaseVector);
     }
 
     //FYSOS Kapitel Identy Device
@@ -188,311 +229,430 @@ namespace Device::Storage {
         sector_size[portno] = SATA_Identify_info->sector_bytes;
 
         log.info("Found SATA drive on port [%d]: %s %s (Firmware: [%s])", portno, mdl, serial, fw);
+
+        //Use all command slots, with native command queuing if both HBA and device support it
+        auto &state = commandState[portno];
+        state.slotCount = ((hbaMem->cap >> 8) & 0x1F) + 1;
+        state.ncq = (hbaMem->cap & HBA_CAP_SNCQ) && (SATA_Identify_info->sata_capability & ATA_SATA_CAP_NCQ);
+        if (state.ncq) {
+            uint32_t queueDepth = (SATA_Identify_info->queue_depth & 0x1F) + 1;
+            if (queueDepth < state.slotCount) {
+                state.slotCount = queueDepth;
+            }
+            state.logBuffer = reinterpret_cast<uint8_t*>(memoryService.mapIO(512));
+            log.info("Using native command queuing on port [%d] with [%u] command slots", portno, state.slotCount);
+        } else {
+            log.info("Using [%u] command slots on port [%d] without native command queuing", state.slotCount, portno);
+        }
         return 0;
     }
 
     bool AhciController::read(HBA_PORT *port,int portno, uint32_t startl, uint32_t starth, uint32_t count, void* buffer){
-        auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();  
+        return transfer(port, portno, startl, starth, count, buffer, false);
+    }
+
+    //Nur für Testzwecke
+    bool AhciController::readOneSector(HBA_PORT *port, int portno, uint32_t startl, uint32_t starth){
+        auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
+        auto dba = reinterpret_cast<uint32_t*>(memoryService.mapIO(512));
 
-        // Clear pending interrupt bits
-        port->is = (uint32_t) -1;
-        int spin = 0;
-        int slot = find_cmdslot(port);
-        if (slot == -1)
+        // Use the regular command path, so that the slot is not taken from a concurrent transfer
+        if (!transfer(port, portno, startl, starth, 1, dba, false)) {
             return false;
+        }
 
-        HBA_CMD_HEADER *cmdheader = (HBA_CMD_HEADER*) vpa[portno].cmdList;
-        cmdheader += slot;
-        cmdheader->prdtl = (uint16_t)((count-1)/16) + 1;	// PRDT entries count
-        cmdheader->pmp = 0;		// Port multiplier value
-	    cmdheader->a = 0;   	// ATAPI
-	    cmdheader->w = 0;		// Write
-	    cmdheader->p = 0;		// Prefetchable 0
-        cmdheader->r = 0;		// Reset
-	    cmdheader->b = 0;	    // BIST
-	    cmdheader->c = 0;	    // Clear busy upon R_OK 0
-        cmdheader->cfl = sizeof(FIS_REG_H2D) / 4;    // Command FIS length | sizeof(FIS_REG_H2D) / 4;
+        //print the buffer
+        for(int i = 0; i < 512 / 4; i++){
+            log.info("buffer[%d]: %x", i, dba[i]);
+        }
+        return true;
+    }
 
-        HBA_CMD_TBL *cmdtbl = (HBA_CMD_TBL*) vpa[portno].commandTable[slot];
+    //Nur für Testzwecke
+    bool AhciController::writeOneSector(HBA_PORT *port, int portno, uint32_t startl, uint32_t starth){
+        auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
+        auto dba = reinterpret_cast<uint32_t*>(memoryService.mapIO(512));
 
-        auto bufphy = memoryService.getPhysicalAddress(buffer);
-        // 8K bytes (16 sectors) per PRDT
-        int i = 0;
-        for (i = 0; i < cmdheader->prdtl - 1; i++){
-            cmdtbl->prdt_entry[i].dba = (uint32_t)bufphy;
-            cmdtbl->prdt_entry[i].dbc = 8191; //zero-based byte count
-            bufphy = bufphy + 4*1024; // 4K bytes
-            count -= 16;
+        for(int i = 0; i < 512 / 4; i++){
+            dba[i] = 0x12345678;
         }
 
-        cmdtbl->prdt_entry[i].dba = (uint32_t)bufphy;
-        cmdtbl->prdt_entry[i].dbc = (count * 512) - 1; // 512 bytes per sector
+        return transfer(port, portno, startl, starth, 1, dba, true);
+    }
 
-        FIS_REG_H2D *cmdfis = (FIS_REG_H2D*) cmdtbl->cfis;
-        cmdfis->fis_type = FIS_TYPE_REG_H2D; //0x27
-        cmdfis->c = 1; //Command
-        cmdfis->command = ATA_CMD_READ_DMA_EX; //0x25;
-        cmdfis->featurel = 0x00;
-        cmdfis->featureh = 0x00;
-        cmdfis->device   = 0xA0;	// LBA mode
-        cmdfis->lba0     = (uint8_t)startl;
-        cmdfis->lba1     = (uint8_t)(startl >> 8);
-        cmdfis->lba2     = (uint8_t)(startl >> 16);
-        cmdfis->lba3     = (uint8_t)(startl >> 24);
-        cmdfis->lba4     = (uint8_t)starth;
-        cmdfis->lba5     = (uint8_t)(starth >> 8);
-        cmdfis->control  = 0x08;
+    bool AhciController::write(HBA_PORT *port,int portno, uint32_t startl, uint32_t starth, uint32_t count, void* buffer){
+        return transfer(port, portno, startl, starth, count, buffer, true);
+    }
 
-        cmdfis->countl = count & 0xFF;
-        cmdfis->counth = (count >> 8) & 0xFF;
-        cmdfis->rsv0     = 0x00;
+    bool AhciController::transfer(HBA_PORT *port, int portno, uint32_t startl, uint32_t starth, uint32_t count, void *buffer, bool write) {
+        auto &state = commandState[portno];
 
-        // The below loop waits until the port is no longer busy before issuing the command
-        while ((port->tfd & (ATA_DEV_BUSY | ATA_DEV_DRQ)) && spin < 1000000) {
-            spin++;
+        if (count == 0 || count > MAX_SECTORS_PER_COMMAND) {
+            log.error("Invalid sector count [%u] (Max: [%u])", count, MAX_SECTORS_PER_COMMAND);
+            return false;
         }
 
-        if (spin == 1000000) {
-            log.error("Port is hung");
+        uint32_t slot = allocateSlot(portno);
+        if (slot == NO_SLOT) {
+            log.error("No SATA drive on port [%d]", portno);
             return false;
         }
 
-        port->ci = 1 << slot;	// Issue command
-
-        // Wait for completion
-        while (1) {
-            // In some longer duration reads, it may be helpful to spin on the DPS bit
-            // in the PxIS port field as well (1 << 5)
-            if ((port->ci & (1 << slot)) == 0) 
+        // Commands, which have been aborted by error recovery, are prepared and issued again
+        auto status = COMMAND_ABORTED;
+        while (status == COMMAND_ABORTED) {
+            if (state.slotCount == 0) {
+                status = COMMAND_FAILED; // Port has been disabled by error recovery
                 break;
-            if (port->is & HBA_PxIS_TFES) {	// Task file error
-                log.error("Read disk error");
-                return false;
+            }
+
+            prepareCommand(portno, slot, startl, starth, count, buffer, write);
+
+            // The HBA delays queued commands until the device is ready to accept them, so there is no need to wait for BSY/DRQ here
+            if (issueCommand(port, portno, slot)) {
+                status = waitForCommand(portno, slot);
             }
         }
 
-        // Check again
-        if (port->is & HBA_PxIS_TFES) {
-            log.error("Read disk error");
+        Util::Async::Atomic<uint32_t>(state.usedSlots).bitReset(slot);
+
+        if (status == COMMAND_FAILED) {
+            log.error("%s disk error on port [%d] (Sector: [%u], Count: [%u])", write ? "Write" : "Read", portno, startl, count);
             return false;
         }
 
         return true;
     }
 
-    //Nur für Testzwecke
-    bool AhciController::readOneSector(HBA_PORT *port, int portno, uint32_t startl, uint32_t starth){
+    void AhciController::prepareCommand(int portno, uint32_t slot, uint32_t startl, uint32_t starth, uint32_t count, void *buffer, bool write) {
         auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
-        port->is = (uint32_t) -1;		// Clear pending interrupt bits
-
-        //get unused command slot
-        uint32_t slot = find_cmdslot(port);
+        auto &state = commandState[portno];
 
         HBA_CMD_HEADER *cmdheader = (HBA_CMD_HEADER*) vpa[portno].cmdList;
         cmdheader += slot;
-        cmdheader->prdtl = 1;	// PRDT entries count
+        cmdheader->prdtl = (uint16_t)((count-1)/SECTORS_PER_PRDT) + 1;	// PRDT entries count
         cmdheader->pmp = 0;		// Port multiplier value
-	    cmdheader->a = 0;   	// ATAPI
-	    cmdheader->w = 0;		// Write, 1: H2D, 0: D2H
-	    cmdheader->p = 0;		// Prefetchable 0
+        cmdheader->a = 0;   	// ATAPI
+        cmdheader->w = write ? 1 : 0;		// Write, 1: H2D, 0: D2H
+        cmdheader->p = 0;		// Prefetchable 0
         cmdheader->r = 0;		// Reset
-	    cmdheader->b = 0;	    // BIST
-	    cmdheader->c = 0;	    // Clear busy upon R_OK 0
-        cmdheader->cfl = 5;    // Command FIS length | sizeof(FIS_REG_H2D) / 4;
+        cmdheader->b = 0;	    // BIST
+        cmdheader->c = 0;	    // Clear busy upon R_OK 0
+        cmdheader->cfl = sizeof(FIS_REG_H2D) / 4;    // Command FIS length | sizeof(FIS_REG_H2D) / 4;
+        cmdheader->prdbc = 0;
 
         HBA_CMD_TBL *cmdtbl = (HBA_CMD_TBL*) vpa[portno].commandTable[slot];
 
-        //FIS
+        // 8K bytes (16 sectors) per PRDT
+        auto bufphy = reinterpret_cast<uint32_t>(memoryService.getPhysicalAddress(buffer));
+        uint32_t remaining = count;
+        int i = 0;
+        for (i = 0; i < cmdheader->prdtl - 1; i++){
+            cmdtbl->prdt_entry[i].dba = bufphy;
+            cmdtbl->prdt_entry[i].dbau = 0;
+            cmdtbl->prdt_entry[i].dbc = (SECTORS_PER_PRDT * 512) - 1; //zero-based byte count
+            cmdtbl->prdt_entry[i].i = 0;
+            bufphy += SECTORS_PER_PRDT * 512;
+            remaining -= SECTORS_PER_PRDT;
+        }
+
+        cmdtbl->prdt_entry[i].dba = bufphy;
+        cmdtbl->prdt_entry[i].dbau = 0;
+        cmdtbl->prdt_entry[i].dbc = (remaining * 512) - 1; // 512 bytes per sector
+        cmdtbl->prdt_entry[i].i = 0;
+
         FIS_REG_H2D *cmdfis = (FIS_REG_H2D*) cmdtbl->cfis;
         cmdfis->fis_type = FIS_TYPE_REG_H2D; //0x27
+        cmdfis->pmport = 0;
         cmdfis->c = 1; //Command
-        cmdfis->command = ATA_CMD_READ_DMA_EX; //0xEC
-        cmdfis->countl   = 0x01;
-        cmdfis->counth   = 0x00;
-        cmdfis->featurel = 0x00;
-        cmdfis->featureh = 0x00;
-        cmdfis->device   = 0xA0;
         cmdfis->lba0     = (uint8_t)startl;
         cmdfis->lba1     = (uint8_t)(startl >> 8);
         cmdfis->lba2     = (uint8_t)(startl >> 16);
         cmdfis->lba3     = (uint8_t)(startl >> 24);
         cmdfis->lba4     = (uint8_t)starth;
         cmdfis->lba5     = (uint8_t)(starth >> 8);
+        cmdfis->icc      = 0x00;
         cmdfis->control  = 0x08;
         cmdfis->rsv0     = 0x00;
 
-        auto dba = reinterpret_cast<uint32_t*>(memoryService.mapIO(512));
-        auto dbaphy = reinterpret_cast<uint32_t>(memoryService.getPhysicalAddress(dba));
-        cmdtbl->prdt_entry[0].dba = dbaphy;
-        cmdtbl->prdt_entry[0].dbc = 0x1FF; //511 bytes
+        if (state.ncq) {
+            // FPDMA QUEUED: sector count in the feature register, command tag (= slot) in count bits 7:3
+            cmdfis->command = write ? ATA_CMD_WRITE_FPDMA_QUEUED : ATA_CMD_READ_FPDMA_QUEUED; //0x61 : 0x60
+            cmdfis->featurel = count & 0xFF;
+            cmdfis->featureh = (count >> 8) & 0xFF;
+            cmdfis->countl   = slot << 3;
+            cmdfis->counth   = 0x00;
+            cmdfis->device   = 0x40;	// LBA mode
+        } else {
+            cmdfis->command = write ? ATA_CMD_WRITE_DMA_EX : ATA_CMD_READ_DMA_EX; //0x35 : 0x25
+            cmdfis->featurel = 0x00;
+            cmdfis->featureh = 0x00;
+            cmdfis->countl   = count & 0xFF;
+            cmdfis->counth   = (count >> 8) & 0xFF;
+            cmdfis->device   = 0xA0;	// LBA mode
+        }
+    }
 
-        //Ensure that device is not busy
-        while (port->tfd & (ATA_DEV_BUSY | ATA_DEV_DRQ)); 
-                                                                        
-        //Issue command
-        port->ci = 1 << slot;
+    uint32_t AhciController::allocateSlot(int portno) {
+        auto &state = commandState[portno];
+        auto usedSlots = Util::Async::Atomic<uint32_t>(state.usedSlots);
 
-        //Wait for command completion
-        while (1) {
-            if ((port->ci & (1 << slot)) == 0) 
-                break;
-            if (port->is & HBA_PxIS_TFES) { //Task file error
-                log.error("Read disk error\n");
-                return false;
+        while (state.slotCount > 0) {
+            for (uint32_t i = 0; i < state.slotCount; i++) {
+                if (!usedSlots.bitTestAndSet(i)) {
+                    // No new commands may be prepared while the port recovers, since recovery may use any reserved slot
+                    awaitRecovery(portno, i);
+                    return i;
+                }
             }
+
+            // All slots are in flight -> Let the device work and try again later
+            Util::Async::Thread::yield();
         }
 
-        //print the buffer
-        for(int i = 0; i < 512 / 4; i++){
-            log.info("buffer[%d]: %x", i, dba[i]);
+        return NO_SLOT;
+    }
+
+    bool AhciController::issueCommand(HBA_PORT *port, int portno, uint32_t slot) {
+        // The interrupt handler (possibly running on another core) must not see the slot as issued, before it has been written to PxSACT/PxCI
+        auto &state = commandState[portno];
+        Device::Cpu::disableInterrupts();
+        while (!state.lock.tryAcquire()) {}
+
+        // An error of another command may have stopped the port after this slot has been allocated
+        if (state.recovering) {
+            state.lock.release();
+            Device::Cpu::enableInterrupts();
+            awaitRecovery(portno, slot);
+            return false;
+        }
+
+        Util::Async::Atomic<uint32_t>(state.issuedSlots).bitSet(slot);
+        if (state.ncq) {
+            port->sact = 1u << slot;
         }
+        port->ci = 1u << slot;
+
+        state.lock.release();
+        Device::Cpu::enableInterrupts();
         return true;
     }
 
-    //Nur für Testzwecke
-    bool AhciController::writeOneSector(HBA_PORT *port, int portno, uint32_t startl, uint32_t starth){
-        auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
-        port->is = (uint32_t) -1;		// Clear pending interrupt bits
+    AhciController::CommandStatus AhciController::waitForCommand(int portno, uint32_t slot) {
+        auto &state = commandState[portno];
+        auto completedSlots = Util::Async::Atomic<uint32_t>(state.completedSlots);
+        auto recoverySlots = Util::Async::Atomic<uint32_t>(state.recoverySlots);
 
-        //get unused command slot
-        uint32_t slot = find_cmdslot(port);
+        while (!completedSlots.bitTest(slot)) {
+            if (recoverySlots.bitTest(slot)) {
+                awaitRecovery(portno, slot);
+                recoverySlots.bitReset(slot);
+                return Util::Async::Atomic<uint32_t>(state.failedSlots).bitTestAndReset(slot) ? COMMAND_FAILED : COMMAND_ABORTED;
+            }
 
-        HBA_CMD_HEADER *cmdheader = (HBA_CMD_HEADER*) vpa[0].cmdList;
-        cmdheader += slot;
-        cmdheader->prdtl = 1;	// PRDT entries count
-        cmdheader->pmp = 0;		// Port multiplier value
-        cmdheader->a = 0;   	// ATAPI
-        cmdheader->w = 1;		// Write, 1: H2D, 0: D2H
-        cmdheader->p = 0;		// Prefetchable 0
-        cmdheader->r = 0;		// Reset
-        cmdheader->b = 0;	    // BIST
-        cmdheader->c = 0;	    // Clear busy upon R_OK 0
-        cmdheader->cfl = 5;    // Command FIS length | sizeof(FIS_REG_H2D) / 4;
+            // Without an interrupt vector of its own, the controller does not signal completions -> Poll the port
+            if (!completionInterrupts) {
+                Device::Cpu::disableInterrupts();
+                if (state.lock.tryAcquire()) {
+                    handlePortInterrupt(portno);
+                    state.lock.release();
+                }
+                Device::Cpu::enableInterrupts();
+            }
 
-        HBA_CMD_TBL *cmdtbl = (HBA_CMD_TBL*) vpa[0].commandTable[slot];
+            if (!completedSlots.bitTest(slot) && !recoverySlots.bitTest(slot)) {
+                Util::Async::Thread::yield();
+            }
+        }
 
-        //FIS
-        FIS_REG_H2D *cmdfis = (FIS_REG_H2D*) cmdtbl->cfis;
-        cmdfis->fis_type = FIS_TYPE_REG_H2D; //0x27
-        cmdfis->c = 1; //Command
-        cmdfis->command = ATA_CMD_WRITE_DMA_EX; //0xEC
-        cmdfis->countl   = 0x01;
-        cmdfis->counth   = 0x00;
-        cmdfis->featurel = 0x00;
-        cmdfis->featureh = 0x00;
-        cmdfis->device   = 0xA0;
-        cmdfis->lba0     = (uint8_t)startl;
-        cmdfis->lba1     = (uint8_t)(startl >> 8);
-        cmdfis->lba2     = (uint8_t)(startl >> 16);
-        cmdfis->lba3     = (uint8_t)(startl >> 24);
-        cmdfis->lba4     = (uint8_t)starth;
-        cmdfis->lba5     = (uint8_t)(starth >> 8);
-        cmdfis->rsv0     = 0x00;
+        completedSlots.bitReset(slot);
+        return COMMAND_SUCCESSFUL;
+    }
 
-        auto dba = reinterpret_cast<uint32_t*>(memoryService.mapIO(512));
+    void AhciController::handlePortInterrupt(int portno) {
+        auto &port = hbaMem->ports[portno];
+        auto &state = commandState[portno];
+        auto issuedSlots = Util::Async::Atomic<uint32_t>(state.issuedSlots);
 
-        for(int i = 0; i < 512 / 4; i++){
-            dba[i] = 0x12345678;
+        uint32_t status = port.is;
+        port.is = status;
+
+        // The port stays stopped until a thread has recovered it, which needs to know about further errors (e.g. while reading the error log)
+        if (state.recovering) {
+            state.errorStatus = state.errorStatus | status;
+            return;
         }
 
-        auto dbaphy = reinterpret_cast<uint32_t>(memoryService.getPhysicalAddress(dba));
-        cmdtbl->prdt_entry[0].dba = dbaphy;
-        cmdtbl->prdt_entry[0].dbc = 0x1FF; //512 bytes
+        uint32_t active = port.ci | port.sact;
+        uint32_t finished = issuedSlots.get() & ~active;
 
-        //Ensure that device is not busy
-        while (port->tfd & (ATA_DEV_BUSY | ATA_DEV_DRQ));
+        if (status & HBA_PxIS_ERROR) {
+            // The HBA stops processing the command list on error -> Leave the recovery to the threads outside of interrupt context
+            uint32_t aborted = issuedSlots.get() & active;
+            state.errorSlots = aborted;
+            state.errorCommandSlot = (port.cmd >> 8) & 0x1F;
+            state.errorStatus = status;
+            state.recovering = true;
 
-        //Issue command
-        port->ci = 1 << slot;
+            for (uint32_t i = 0; aborted != 0; i++, aborted >>= 1) {
+                if ((aborted & 1) && issuedSlots.bitTestAndReset(i)) {
+                    Util::Async::Atomic<uint32_t>(state.recoverySlots).bitSet(i);
+                }
+            }
+        }
 
-        //Wait for command completion
-        while (1) {
-            if ((port->ci & (1 << slot)) == 0) 
-                break;
-            if (port->is & HBA_PxIS_TFES) { //Task file error
-                log.error("Write disk error\n");
-                return false;
+        for (uint32_t i = 0; finished != 0; i++, finished >>= 1) {
+            if ((finished & 1) && issuedSlots.bitTestAndReset(i)) {
+                Util::Async::Atomic<uint32_t>(state.completedSlots).bitSet(i);
             }
         }
-        return true;
     }
 
-    bool AhciController::write(HBA_PORT *port,int portno, uint32_t startl, uint32_t starth, uint32_t count, void* buffer){
-        auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
+    void AhciController::awaitRecovery(int portno, uint32_t slot) {
+        auto &state = commandState[portno];
 
-        hbaMem->is = (uint32_t) -1;		// Clear pending interrupt bits
-        int slot = find_cmdslot(port);
-        if (slot == -1)
+        while (state.recovering) {
+            if (state.recoveryLock.tryAcquire()) {
+                if (state.recovering) {
+                    recoverPort(portno, slot);
+                }
+                state.recoveryLock.release();
+            } else {
+                Util::Async::Thread::yield();
+            }
+        }
+    }
+
+    void AhciController::recoverPort(int portno, uint32_t slot) {
+        auto &port = hbaMem->ports[portno];
+        auto &state = commandState[portno];
+        uint32_t errorSlots = state.errorSlots;
+        uint32_t failed = errorSlots;
+
+        // Clearing PxCMD.ST also clears PxCI and PxSACT; If the device is still busy afterwards, only a COMRESET brings it back
+        stop_cmd(&port);
+        port.serr = 0xFFFFFFFF;
+        bool reset = !(state.errorStatus & HBA_PxIS_TFES) || (port.tfd & (ATA_DEV_BUSY | ATA_DEV_DRQ));
+        bool ready = !reset || resetDevice(&port);
+
+        if (ready) {
+            port.is = 0xFFFFFFFF;
+            start_cmd(&port);
+        }
+
+        if (ready && !reset) {
+            if (state.ncq) {
+                uint32_t tag;
+                if (!readNcqErrorLog(&port, portno, slot, tag)) {
+                    // Reset the device, which also clears its command queue and error state
+                    log.warn("Failed to read NCQ command error log on port [%d]", portno);
+                    stop_cmd(&port);
+                    port.serr = 0xFFFFFFFF;
+                    ready = resetDevice(&port);
+                    if (ready) {
+                        port.is = 0xFFFFFFFF;
+                        start_cmd(&port);
+                    }
+                } else if (tag != NO_SLOT && (errorSlots & (1u << tag))) {
+                    failed = 1u << tag;
+                }
+            } else if (errorSlots & (1u << state.errorCommandSlot)) {
+                // Without NCQ, the HBA executes commands in order and stops at the failed one, so that the others have not been executed
+                failed = 1u << state.errorCommandSlot;
+            }
+        }
+
+        if (ready) {
+            log.warn("Recovered port [%d] from error (Status: [0x%x], Failed slots: [0x%x], Aborted slots: [0x%x])", portno, state.errorStatus, failed, errorSlots & ~failed);
+        } else {
+            log.error("Device on port [%d] does not respond after COMRESET -> Disabling port", portno);
+            state.slotCount = 0;
+        }
+
+        for (uint32_t i = 0; failed != 0; i++, failed >>= 1) {
+            if (failed & 1) {
+                Util::Async::Atomic<uint32_t>(state.failedSlots).bitSet(i);
+            }
+        }
+
+        state.errorStatus = 0;
+        state.recovering = false;
+    }
+
+    bool AhciController::resetDevice(HBA_PORT *port) {
+        if (!portReset(port)) {
             return false;
+        }
+
+        // The device signals readiness with its signature FIS, which is only received with PxCMD.FRE set
+        port->cmd |= HBA_PxCMD_FRE;
+        for (uint32_t timeout = 0; (port->tfd & (ATA_DEV_BUSY | ATA_DEV_DRQ)) && timeout < RECOVERY_TIMEOUT; timeout++) {
+            Util::Async::Thread::sleep(Util::Time::Timestamp::ofMilliseconds(1));
+        }
+
+        port->serr = 0xFFFFFFFF;
+        return !(port->tfd & (ATA_DEV_BUSY | ATA_DEV_DRQ));
+    }
+
+    bool AhciController::readNcqErrorLog(HBA_PORT *port, int portno, uint32_t slot, uint32_t &tag) {
+        auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
+        auto &state = commandState[portno];
 
         HBA_CMD_HEADER *cmdheader = (HBA_CMD_HEADER*) vpa[portno].cmdList;
         cmdheader += slot;
-        cmdheader->prdtl = (uint16_t)((count-1)/16) + 1;	// PRDT entries count
+        cmdheader->prdtl = 1;	// PRDT entries count
         cmdheader->pmp = 0;		// Port multiplier value
         cmdheader->a = 0;   	// ATAPI
-        cmdheader->w = 1;		// Write
-	    cmdheader->p = 0;		// Prefetchable 0
+        cmdheader->w = 0;		// Write, 1: H2D, 0: D2H
+        cmdheader->p = 0;		// Prefetchable 0
         cmdheader->r = 0;		// Reset
-	    cmdheader->b = 0;	    // BIST
-	    cmdheader->c = 0;	    // Clear busy upon R_OK 0
+        cmdheader->b = 0;	    // BIST
+        cmdheader->c = 0;	    // Clear busy upon R_OK 0
         cmdheader->cfl = sizeof(FIS_REG_H2D) / 4;    // Command FIS length | sizeof(FIS_REG_H2D) / 4;
+        cmdheader->prdbc = 0;
 
         HBA_CMD_TBL *cmdtbl = (HBA_CMD_TBL*) vpa[portno].commandTable[slot];
-
-        auto bufphy = memoryService.getPhysicalAddress(buffer);
-        int i = 0;
-        for (i = 0; i < cmdheader->prdtl - 1; i++){
-            cmdtbl->prdt_entry[i].dba = (uint32_t)bufphy;
-            cmdtbl->prdt_entry[i].dbc = 8191;
-            bufphy = (uint8_t*)bufphy + 4*1024;
-            count -= 16;
-        }
-
-        cmdtbl->prdt_entry[i].dba = (uint32_t)bufphy;
-        cmdtbl->prdt_entry[i].dbc = (count * 512) - 1; // 512 bytes per sector
+        cmdtbl->prdt_entry[0].dba = reinterpret_cast<uint32_t>(memoryService.getPhysicalAddress(state.logBuffer));
+        cmdtbl->prdt_entry[0].dbau = 0;
+        cmdtbl->prdt_entry[0].dbc = 0x1FF; //512 bytes
+        cmdtbl->prdt_entry[0].i = 0;
 
         FIS_REG_H2D *cmdfis = (FIS_REG_H2D*) cmdtbl->cfis;
-        cmdfis->fis_type = FIS_TYPE_REG_H2D;
-        cmdfis->command = ATA_CMD_WRITE_DMA_EX; //0x35
-        cmdfis->c = 1;	// Command
+        cmdfis->fis_type = FIS_TYPE_REG_H2D; //0x27
+        cmdfis->pmport = 0;
+        cmdfis->c = 1; //Command
+        cmdfis->command  = ATA_CMD_READ_LOG_EXT; //0x2F
         cmdfis->featurel = 0x00;
         cmdfis->featureh = 0x00;
-        cmdfis->device   = 0xA0;	// LBA mode
-        cmdfis->lba0     = (uint8_t)startl;
-        cmdfis->lba1     = (uint8_t)(startl >> 8);
-        cmdfis->lba2     = (uint8_t)(startl >> 16);
-        cmdfis->lba3     = (uint8_t)(startl >> 24);
-        cmdfis->lba4     = (uint8_t)starth;
-        cmdfis->lba5     = (uint8_t)(starth >> 8);
+        cmdfis->lba0     = ATA_LOG_NCQ_COMMAND_ERROR; // Log address
+        cmdfis->lba1     = 0x00; // Page number
+        cmdfis->lba2     = 0x00;
+        cmdfis->lba3     = 0x00;
+        cmdfis->lba4     = 0x00;
+        cmdfis->lba5     = 0x00;
+        cmdfis->countl   = 0x01; // Number of pages
+        cmdfis->counth   = 0x00;
+        cmdfis->device   = 0xA0;
+        cmdfis->icc      = 0x00;
         cmdfis->control  = 0x08;
-
-        cmdfis->countl = count & 0xFF;
-        cmdfis->counth = (count >> 8) & 0xFF;
         cmdfis->rsv0     = 0x00;
 
-        // The below loop waits until the port is no longer busy before issuing the command
-        while ((port->tfd & (ATA_DEV_BUSY | ATA_DEV_DRQ)));
+        // PxTFD still shows the error of the failed command, so errors of this command are only visible in PxIS
+        Device::Cpu::disableInterrupts();
+        while (!state.lock.tryAcquire()) {}
+        state.errorStatus = 0;
+        port->ci = 1u << slot;
+        state.lock.release();
+        Device::Cpu::enableInterrupts();
 
-        port->ci = 1 << slot;	// Issue command
-
-        // Wait for completion
-        while (1) {
-            // In some longer duration reads, it may be helpful to spin on the DPS bit
-            // in the PxIS port field as well (1 << 5)
-            if ((port->ci & (1 << slot)) == 0) 
-                break;
-            if (port->is & HBA_PxIS_TFES) {	// Task file error
-                log.error("Write disk error");
+        for (uint32_t timeout = 0; port->ci & (1u << slot); timeout++) {
+            if (((port->is | state.errorStatus) & HBA_PxIS_ERROR) || timeout >= RECOVERY_TIMEOUT) {
                 return false;
             }
+            Util::Async::Thread::sleep(Util::Time::Timestamp::ofMilliseconds(1));
         }
 
-        // Check again
-        if (port->is & HBA_PxIS_TFES) {
-            log.error("Write disk error");
-            return false;
-        }
-
+        tag = (state.logBuffer[0] & ATA_NCQ_ERROR_LOG_NQ) ? NO_SLOT : (state.logBuffer[0] & 0x1F);
         return true;
     }
 
@@ -608,7 +768,8 @@ namespace Device::Storage {
         return 0;
     }
 
-    void AhciController::portReset(HBA_PORT *port) {
+    bool AhciController::portReset(HBA_PORT *port) {
+        int timeout = 0;
 
         //write 1 PxSCTL.DET to 1
         port->sctl |= (1 << 0);
@@ -617,11 +778,13 @@ namespace Device::Storage {
         port->sctl  &= ~(1 << 0);
 
         //wait until PxSSTS.DET is 3
-        while((port->ssts & 0x0F) != HBA_PORT_DET_PRESENT){
+        while((port->ssts & 0x0F) != HBA_PORT_DET_PRESENT && timeout < 200){
             Util::Async::Thread::sleep(Util::Time::Timestamp::ofMilliseconds(5));
+            timeout++;
         }
 
         port->serr = 0xFFFFFFFF;
+        return (port->ssts & 0x0F) == HBA_PORT_DET_PRESENT;
     }
 
     void AhciController::start_cmd(HBA_PORT *port) {
@@ -686,12 +849,46 @@ namespace Device::Storage {
 
     void AhciController::plugin() {
         auto &interruptService = Kernel::System::getService<Kernel::InterruptService>();
-        interruptService.assignInterrupt(Kernel::InterruptVector::AHCI, *this);
-        interruptService.allowHardwareInterrupt(Device::InterruptRequest::AHCI);
+        if (msiVectorCount == 0) {
+            interruptService.assignInterrupt(Kernel::InterruptVector::AHCI, *this);
+            interruptService.allowHardwareInterrupt(Device::InterruptRequest::AHCI);
+            return;
+        }
+
+        for (uint8_t i = 0; i < msiVectorCount; i++) {
+            interruptService.assignInterrupt(static_cast<Kernel::InterruptVector>(msiBaseVector + i), *this);
+        }
+
+        // Message signaled interrupts are edge-triggered and cannot be shared, so HBA interrupts can be enabled safely
+        hbaMem->is = 0xFFFFFFFF;
+        hbaMem->ghc = hbaMem->ghc | HBA_GHC_IE;
+        completionInterrupts = true;
     }
 
     void AhciController::trigger(const Kernel::InterruptFrame &frame) {
-        log.info("AHCI Interrupt triggered");
+        uint32_t pendingPorts = hbaMem->is;
+
+        // With one vector per port, the vector identifies the port and no other port needs to be checked
+        if (msiVectorCount > 1 && !(hbaMem->ghc & HBA_GHC_MRSM)) {
+            uint32_t port = frame.interrupt - msiBaseVector;
+            if (port + 1 < msiVectorCount) {
+                pendingPorts &= (1 << port);
+            } else {
+                pendingPorts &= ~((1 << port) - 1); // The last vector is shared by all remaining ports
+            }
+        }
+
+        // Port interrupt status (PxIS) must be cleared before the port's bit in the HBA interrupt status
+        for (uint32_t i = 0; i < AHCI_MAX_PORTS; i++) {
+            if (pendingPorts & (1u << i)) {
+                // Interrupts are already disabled here and issuers hold the lock only for a few register writes
+                while (!commandState[i].lock.tryAcquire()) {}
+                handlePortInterrupt(i);
+                commandState[i].lock.release();
+            }
+        }
+
+        hbaMem->is = pendingPorts;
     }
 
     //Used for benchmarking
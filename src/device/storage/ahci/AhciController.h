@@ -17,6 +17,7 @@ namespace Device {
 namespace Kernel {
     class Logger;
     struct InterruptFrame;
+    enum InterruptVector : uint8_t;
 }  // namespace Kernel
 
 namespace Device::Storage {
@@ -27,6 +28,24 @@ namespace Device::Storage {
         uint32_t* commandTable[32];
     } virtual_port_addr_t;
 
+    // Command slot bookkeeping of a port, shared between issuing threads and the interrupt handler
+    typedef struct port_command_state{
+        uint32_t slotCount;      // Number of usable command slots (limited by the HBA and the device queue depth)
+        bool ncq;                // Use READ/WRITE FPDMA QUEUED instead of READ/WRITE DMA EXT
+        uint32_t usedSlots;      // Slots reserved by a thread
+        uint32_t issuedSlots;    // Slots handed to the HBA, which have not completed yet
+        uint32_t completedSlots; // Slots completed by the HBA, which have not been collected by their thread yet
+        uint32_t failedSlots;    // Completed slots, which ended with an error
+        uint32_t recoverySlots;  // Slots, which were still active when the port stopped on an error and wait for recovery
+        uint32_t errorSlots;     // Slots, which were still active when the port stopped on an error
+        uint32_t errorCommandSlot; // PxCMD.CCS when the port stopped on an error (the failed command without NCQ)
+        volatile uint32_t errorStatus; // PxIS bits seen by the interrupt handler since the port stopped on an error
+        volatile bool recovering; // Set by the interrupt handler on error; no commands are issued until a thread has recovered the port
+        uint8_t *logBuffer;      // Buffer for the NCQ command error log (only allocated with NCQ)
+        Util::Async::Spinlock lock; // Held with interrupts disabled, while issuedSlots and PxSACT/PxCI are changed or compared
+        Util::Async::Spinlock recoveryLock; // Held by the thread, which recovers the port
+    } port_command_state_t;
+
     //https://forum.osdev.org/viewtopic.php?f=1&t=30118
     typedef volatile struct SATA_ident{
         unsigned short   config;      /* lots of obsolete bit flags */
@@ -314,7 +333,7 @@ namespace Device::Storage {
             static int enableAHCIController(const Device::PciDevice &device);
             static int check_type(HBA_PORT *port);
             static int hbaReset();
-            static void portReset(HBA_PORT *port);
+            static bool portReset(HBA_PORT *port);
             static void start_cmd(HBA_PORT *port);
             static void stop_cmd(HBA_PORT *port);
             static void port_rebase(HBA_PORT *port, int portno);
@@ -325,6 +344,86 @@ namespace Device::Storage {
             static void test_read_write(int portno, uint64_t sector, int repeats);
 
         private:
+            enum CommandStatus : uint8_t {
+                COMMAND_SUCCESSFUL,
+                COMMAND_FAILED,
+                COMMAND_ABORTED // Aborted by error recovery, before the device executed it -> Needs to be issued again
+            };
+
+            /**
+             * Try to switch the controller to message signaled interrupts, using one vector per port if possible.
+             */
+            void enableMessageSignaledInterrupts(const PciDevice &device);
+
+            /**
+             * Read or write up to MAX_SECTORS_PER_COMMAND sectors, using a free command slot of the port.
+             * Multiple threads may call this concurrently, in which case their commands are queued in the HBA
+             * (and in the device, if it supports native command queuing).
+             */
+            static bool transfer(HBA_PORT *port, int portno, uint32_t startl, uint32_t starth, uint32_t count, void *buffer, bool write);
+
+            /**
+             * Write the command FIS and the PRDT of a read or write command into a reserved command slot.
+             */
+            static void prepareCommand(int portno, uint32_t slot, uint32_t startl, uint32_t starth, uint32_t count, void *buffer, bool write);
+
+            /**
+             * Reserve a free command slot, yielding until one becomes available and while the port is recovering from an error.
+             *
+             * @return NO_SLOT, if the port has been disabled
+             */
+            static uint32_t allocateSlot(int portno);
+
+            /**
+             * Hand a prepared command slot to the HBA.
+             *
+             * @return false, if the port had to be recovered from an error first, in which case the command must be prepared again
+             */
+            static bool issueCommand(HBA_PORT *port, int portno, uint32_t slot);
+
+            /**
+             * Wait until a command has been completed by the interrupt handler (or by polling, if the controller
+             * has no interrupt vector of its own). If the port stopped on an error, the first waiting thread recovers it.
+             */
+            static CommandStatus waitForCommand(int portno, uint32_t slot);
+
+            /**
+             * Acknowledge the interrupt status of a port and mark all commands, which are no longer active, as completed.
+             * On error, the port is left stopped and all active commands are handed to error recovery (see recoverPort()).
+             * The caller must hold the port's lock with interrupts disabled, so that no command is issued in between.
+             */
+            static void handlePortInterrupt(int portno);
+
+            /**
+             * Recover the port, if it stopped on an error, or wait until another thread has done so.
+             * The calling thread must hold a command slot, which is used for reading the NCQ command error log.
+             */
+            static void awaitRecovery(int portno, uint32_t slot);
+
+            /**
+             * Software error recovery (AHCI 1.3.1, section 6.2.2): Restart the command engine (with a COMRESET,
+             * if the device is still busy or a host bus error occurred), determine the failed command
+             * (via PxCMD.CCS or the NCQ command error log) and mark it as failed. All other commands, which were active
+             * at the time of the error, have been aborted and are issued again by their threads.
+             */
+            static void recoverPort(int portno, uint32_t slot);
+
+            /**
+             * Issue a COMRESET and wait until the device is ready again. The command engine must be stopped.
+             */
+            static bool resetDevice(HBA_PORT *port);
+
+            /**
+             * Read the NCQ command error log (READ LOG EXT, page 10h), which also takes the device out of its error state.
+             *
+             * @param tag Set to the failed command's tag or to NO_SLOT, if the error was caused by a non-queued command
+             * @return false, if the log could not be read
+             */
+            static bool readNcqErrorLog(HBA_PORT *port, int portno, uint32_t slot, uint32_t &tag);
+
+            Kernel::InterruptVector msiBaseVector{};
+            uint8_t msiVectorCount = 0;
+
             static const constexpr uint8_t ATA_CMD_IDENTIFY = 0xEC;
 
             static const constexpr uint8_t PCI_SUBCLASS_AHCI = 0x06; //Indicates that this is a Serial ATA device
@@ -341,11 +440,27 @@ namespace Device::Storage {
             static const uint16_t ATA_CMD_READ_DMA_EX = 0x25;
             static const uint16_t ATA_CMD_WRITE_DMA = 0xCA;
             static const uint16_t ATA_CMD_WRITE_DMA_EX = 0x35;
+            static const uint16_t ATA_CMD_READ_FPDMA_QUEUED = 0x60;
+            static const uint16_t ATA_CMD_WRITE_FPDMA_QUEUED = 0x61;
+            static const uint16_t ATA_CMD_READ_LOG_EXT = 0x2F;
+            static const uint8_t ATA_LOG_NCQ_COMMAND_ERROR = 0x10;
+            static const uint8_t ATA_NCQ_ERROR_LOG_NQ = 0x80; // Byte 0 of the NCQ command error log: Error was caused by a non-queued command
+
+            static const uint16_t ATA_SATA_CAP_NCQ = (1 << 8); // Identify word 76
+            static const uint32_t HBA_CAP_SNCQ = (1 << 30);
+
+            // 8 PRDT entries per command table with 16 sectors each
+            static const uint32_t PRDT_ENTRIES = 8;
+            static const uint32_t SECTORS_PER_PRDT = 16;
+            static const uint32_t MAX_SECTORS_PER_COMMAND = PRDT_ENTRIES * SECTORS_PER_PRDT;
+            static const uint32_t NO_SLOT = 0xFFFFFFFF;
+            static const uint32_t RECOVERY_TIMEOUT = 1000; // Milliseconds
 
             static const uint16_t ATA_DEV_BUSY = 0x80;
             static const uint16_t ATA_DEV_DRQ = 0x08;
 
             static const int HBA_PxIS_TFES = (1 << 30);
+            static const uint32_t HBA_PxIS_ERROR = (1 << 30) | (1 << 29) | (1 << 28) | (1 << 27); // TFES, HBFS, HBDS, IFS
 
             // Definition der Gerätetypen
             static const int AHCI_DEV_NULL = 0;
@@ -358,6 +473,9 @@ namespace Device::Storage {
             static const int HBA_PORT_IPM_ACTIVE = 0x01;
             static const int HBA_PORT_DET_PRESENT = 0x03;
 
+            static const uint32_t HBA_GHC_IE = (1 << 1);
+            static const uint32_t HBA_GHC_MRSM = (1 << 2);
+
             static const uint16_t HBA_PxCMD_ST  =  0x0001;
             static const uint16_t HBA_PxCMD_FRE =  0x0010;
             static const uint16_t HBA_PxCMD_FR  =  0x4000;
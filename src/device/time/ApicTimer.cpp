@@ -27,6 +27,10 @@
 #include "kernel/service/InterruptService.h"
 #include "kernel/interrupt/InterruptVector.h"
 #include "kernel/log/Logger.h"
+#include "device/cpu/Cpu.h"
+#include "device/cpu/ModelSpecificRegister.h"
+#include "lib/util/hardware/CpuId.h"
+#include "lib/util/collection/Array.h"
 
 namespace Kernel {
 struct InterruptFrame;
@@ -36,6 +40,8 @@ namespace Device {
 
 uint32_t ApicTimer::ticksPerMilliseconds = 0;
 ApicTimer::Divider ApicTimer::divider = BY_16;
+uint32_t ApicTimer::timestampCounterTicksPerMicrosecond = 0;
+bool ApicTimer::tscDeadlineAvailable = false;
 Kernel::Logger ApicTimer::log = Kernel::Logger::get("APIC");
 
 ApicTimer::ApicTimer(uint32_t timerInterval, uint32_t yieldInterval) : cpuId(LocalApic::getId()), timerInterval(timerInterval), yieldInterval(yieldInterval) {
@@ -45,9 +51,21 @@ ApicTimer::ApicTimer(uint32_t timerInterval, uint32_t yieldInterval) : cpuId(Loc
     // Recommended order: Divide -> LVT -> Initial Count (OSDev)
     LocalApic::writeDoubleWord(LocalApic::TIMER_DIVIDE, divider); // BY_1 is the highest resolution (overkill)
     LocalApic::LocalVectorTableEntry lvtEntry = LocalApic::readLocalVectorTable(LocalApic::TIMER);
-    lvtEntry.timerMode = LocalApic::LocalVectorTableEntry::TimerMode::PERIODIC;
+
+    if (!isHighResolutionAvailable()) {
+        lvtEntry.timerMode = LocalApic::LocalVectorTableEntry::TimerMode::PERIODIC;
+        LocalApic::writeLocalVectorTable(LocalApic::TIMER, lvtEntry);
+        LocalApic::writeDoubleWord(LocalApic::TIMER_INITIAL, counter);
+        return;
+    }
+
+    lvtEntry.timerMode = tscDeadlineAvailable ? LocalApic::LocalVectorTableEntry::TimerMode::TSC_DEADLINE : LocalApic::LocalVectorTableEntry::TimerMode::ONESHOT;
     LocalApic::writeLocalVectorTable(LocalApic::TIMER, lvtEntry);
-    LocalApic::writeDoubleWord(LocalApic::TIMER_INITIAL, counter);
+
+    auto now = Cpu::readTimestampCounter();
+    tickCycles = static_cast<uint64_t>(timerInterval) * 1000 * timestampCounterTicksPerMicrosecond;
+    nextTick = now + tickCycles;
+    programEvent(now, nextTick);
 }
 
 void ApicTimer::plugin() {
@@ -63,8 +81,31 @@ void ApicTimer::trigger(const Kernel::InterruptFrame &frame) {
         return;
     }
 
+    bool tick = true;
+    bool deadlineExpired = false;
+    if (isHighResolutionAvailable()) {
+        auto now = Cpu::readTimestampCounter();
+        tick = now >= nextTick;
+        if (tick) {
+            // Skip missed ticks (e.g. if interrupts have been disabled for a long time)
+            nextTick = nextTick + tickCycles > now ? nextTick + tickCycles : now + tickCycles;
+        }
+
+        // An expired deadline is retried, until the scheduler has handled it and set a new one
+        deadlineExpired = deadline != NO_DEADLINE && now >= deadline;
+        auto retry = now + static_cast<uint64_t>(RETRY_MICROSECONDS) * timestampCounterTicksPerMicrosecond;
+        auto nextEvent = deadlineExpired ? retry : deadline;
+        programEvent(now, nextEvent < nextTick ? nextEvent : nextTick);
+    }
+
+    if (!tick && !deadlineExpired) {
+        return;
+    }
+
     // Increase the "core-local" time, the system time is still managed by the PIT.
-    time.addNanoseconds(timerInterval * 1000000); // Interval is in milliseconds
+    if (tick) {
+        time.addNanoseconds(timerInterval * 1000000); // Interval is in milliseconds
+    }
 
     if (cpuId != 0) {
         // Currently there is only one scheduler, it should get triggered only by the BSP.
@@ -73,7 +114,7 @@ void ApicTimer::trigger(const Kernel::InterruptFrame &frame) {
         return;
     }
 
-    if (time.toMilliseconds() % yieldInterval == 0) {
+    if (deadlineExpired || (tick && time.toMilliseconds() % yieldInterval == 0)) {
         // Currently there is only one main scheduler, for SMP systems this should yield the core scheduler or something similar.
         Kernel::System::getService<Kernel::SchedulerService>().yield();
     }
@@ -90,16 +131,66 @@ void ApicTimer::calibrate() {
     lvtEntry.timerMode = LocalApic::LocalVectorTableEntry::TimerMode::ONESHOT;
     LocalApic::writeLocalVectorTable(LocalApic::TIMER, lvtEntry);
 
+    // The time stamp counter is calibrated in the same interval, if available
+    bool timestampCounterAvailable = Util::Hardware::CpuId::isAvailable() && (Util::Hardware::CpuId::getCpuFeatureBits() & Util::Hardware::CpuId::TSC) != 0;
+
     // The calibration works by waiting the desired interval and measuring how many ticks the timer does.
+    uint64_t timestampCounterStart = timestampCounterAvailable ? Cpu::readTimestampCounter() : 0;
     LocalApic::writeDoubleWord(LocalApic::TIMER_INITIAL, 0xFFFFFFFF); // Max initial counter, writing starts timer
     Pit::earlyDelay(10000); // Wait 10 ms
     ticksPerMilliseconds = (0xFFFFFFFF - LocalApic::readDoubleWord(LocalApic::TIMER_CURRENT)) / 10; // Ticks in 1 ms
 
     log.info("Apic Timer ticks per millisecond: [%u]", ticksPerMilliseconds);
+
+    if (timestampCounterAvailable) {
+        // 10 ms fit into 32 bits for clock rates below 400 GHz
+        timestampCounterTicksPerMicrosecond = static_cast<uint32_t>(Cpu::readTimestampCounter() - timestampCounterStart) / 10000;
+        tscDeadlineAvailable = (Util::Hardware::CpuId::getCpuFeatureBits() & Util::Hardware::CpuId::TSC_DL) != 0;
+        log.info("Time stamp counter ticks per microsecond: [%u] -> Using %s mode for high resolution timing", timestampCounterTicksPerMicrosecond, tscDeadlineAvailable ? "TSC-deadline" : "one-shot");
+    }
 }
 
 uint8_t ApicTimer::getCpuId() const {
     return cpuId;
 }
 
+void ApicTimer::setDeadline(uint64_t timestampCounterValue) {
+    if (!isHighResolutionAvailable()) {
+        return;
+    }
+
+    // The timer interrupt reprograms the timer as well, so it must not interrupt us here
+    uint32_t flags;
+    asm volatile ("pushf; pop %0; cli" : "=r"(flags) : : "memory");
+
+    deadline = timestampCounterValue;
+    programEvent(Cpu::readTimestampCounter(), deadline < nextTick ? deadline : nextTick);
+
+    asm volatile ("push %0; popf" : : "r"(flags) : "memory", "cc");
+}
+
+bool ApicTimer::isHighResolutionAvailable() {
+    return timestampCounterTicksPerMicrosecond != 0;
+}
+
+uint64_t ApicTimer::toTimestampCounterTicks(const Util::Time::Timestamp &duration) {
+    auto seconds = static_cast<uint64_t>(duration.toSeconds());
+    // Both terms wrap around identically for long durations, so the difference is always the sub-second part
+    auto microseconds = duration.toMicroseconds() - duration.toSeconds() * 1000000;
+    return (seconds * 1000000 + microseconds) * timestampCounterTicksPerMicrosecond;
+}
+
+void ApicTimer::programEvent(uint64_t now, uint64_t event) const {
+    if (tscDeadlineAvailable) {
+        // A deadline in the past triggers the interrupt immediately
+        ModelSpecificRegister(TSC_DEADLINE_MSR).writeQuadWord(event);
+        return;
+    }
+
+    // Events are never more than one tick ahead, so the difference fits into 32 bits
+    auto microseconds = event > now ? static_cast<uint32_t>(event - now) / timestampCounterTicksPerMicrosecond : 0;
+    auto counter = (microseconds / 1000) * ticksPerMilliseconds + ((microseconds % 1000) * ticksPerMilliseconds) / 1000;
+    LocalApic::writeDoubleWord(LocalApic::TIMER_INITIAL, counter == 0 ? 1 : counter);
+}
+
 }
\ No newline at end of file
@@ -41,7 +41,9 @@ namespace Device {
  * in single core systems. It is not used for system-time keeping, this is still done by the PIT.
  *
  * It receives its tick interval in milliseconds, which should be precise enough for scheduling.
- * If a more precise interval is required, the timer divider might need adjustment.
+ * If the time stamp counter is available, the timer is programmed in one-shot mode (or TSC-deadline mode, if supported)
+ * instead of periodic mode. Each interrupt then arms the timer for the next event, which is either the next regular tick
+ * or an earlier deadline (see setDeadline()). This allows the scheduler to wake up sleeping threads with microsecond precision.
  */
 class ApicTimer : public Kernel::InterruptHandler, public TimeProvider {
 
@@ -114,15 +116,51 @@ public:
 
     [[nodiscard]] uint8_t getCpuId() const;
 
+    /**
+     * Arm the timer to additionally fire at a specific time stamp counter value.
+     * Only a single deadline is stored, a new deadline replaces the old one. Once the deadline has passed,
+     * the timer yields the scheduler and keeps firing every few microseconds, until a new deadline is set.
+     * Has no effect, if high resolution timing is not available.
+     *
+     * @param timestampCounterValue The deadline or NO_DEADLINE
+     */
+    void setDeadline(uint64_t timestampCounterValue);
+
+    /**
+     * Check if the timers run in one-shot mode, driven by the time stamp counter (calibrated by calibrate()).
+     */
+    [[nodiscard]] static bool isHighResolutionAvailable();
+
+    /**
+     * Convert a duration into time stamp counter ticks.
+     */
+    [[nodiscard]] static uint64_t toTimestampCounterTicks(const Util::Time::Timestamp &duration);
+
+    static const constexpr uint64_t NO_DEADLINE = UINT64_MAX;
+
 private:
+
+    /**
+     * Program the hardware timer to fire at the given time stamp counter value.
+     */
+    void programEvent(uint64_t now, uint64_t event) const;
     uint8_t cpuId;          // The id of the CPU that uses this timer.
     uint32_t timerInterval; // The interrupt trigger interval in milliseconds.
     uint32_t yieldInterval; // The preemption trigger interval in milliseconds.
 
     Util::Time::Timestamp time{}; // The "core-local" timestamp.
 
+    uint64_t tickCycles = 0;           // The tick interval in time stamp counter ticks (high resolution mode only).
+    uint64_t nextTick = 0;             // The time stamp counter value of the next regular tick.
+    uint64_t deadline = NO_DEADLINE;   // The time stamp counter value of the next additional event.
+
     static uint32_t ticksPerMilliseconds; // The number of ticks the APIC timer does in 10 ms.
     static Divider divider;                // The used divider, it has to be consistent to get consistent timings.
+    static uint32_t timestampCounterTicksPerMicrosecond; // Zero, if the time stamp counter is not available.
+    static bool tscDeadlineAvailable;
+
+    static const constexpr uint32_t TSC_DEADLINE_MSR = 0x6e0;
+    static const constexpr uint32_t RETRY_MICROSECONDS = 50;
 
     static Kernel::Logger log;
 };
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "CachedNode.h"
+
+#include "filesystem/core/PageCache.h"
+#include "filesystem/core/ReadaheadWorker.h"
+#include "lib/util/async/ReentrantSpinlock.h"
+
+namespace Filesystem {
+
+CachedNode::CachedNode(NodeCache &cache, NodeCache::Entry &entry, Util::Async::ReentrantSpinlock &lock) :
+        cache(cache), entry(entry), node(*entry.node), lock(lock) {}
+
+CachedNode::~CachedNode() {
+    lock.acquire();
+    cache.release(entry);
+    lock.release();
+}
+
+Util::String CachedNode::getName() {
+    lock.acquire();
+    auto name = node.getName();
+    return lock.releaseAndReturn(name);
+}
+
+Util::Io::File::Type CachedNode::getType() {
+    lock.acquire();
+    return lock.releaseAndReturn(node.getType());
+}
+
+uint64_t CachedNode::getLength() {
+    lock.acquire();
+    return lock.releaseAndReturn(node.getLength());
+}
+
+Util::Array<Util::String> CachedNode::getChildren() {
+    lock.acquire();
+    auto children = node.getChildren();
+    return lock.releaseAndReturn(children);
+}
+
+uint64_t CachedNode::readData(uint8_t *targetBuffer, uint64_t pos, uint64_t numBytes) {
+    auto *pageCache = entry.pageCache;
+    if (pageCache == nullptr) {
+        lock.acquire();
+        return lock.releaseAndReturn(node.readData(targetBuffer, pos, numBytes));
+    }
+
+    // Cached data is copied without taking the mount point's lock, which may be held by the readahead worker
+    auto read = pageCache->read(targetBuffer, pos, numBytes);
+    auto sequential = pos == nextPosition;
+    if (!sequential) {
+        window = 0;
+        readaheadEnd = 0;
+    }
+
+    if (read < numBytes || (sequential && isReadaheadDue(pos + read))) {
+        lock.acquire();
+        if (read < numBytes) {
+            read += node.readData(targetBuffer + read, pos + read, numBytes - read);
+        }
+
+        if (sequential) {
+            startReadahead(pos + read);
+        }
+
+        lock.release();
+    }
+
+    nextPosition = pos + read;
+    return read;
+}
+
+uint64_t CachedNode::writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) {
+    lock.acquire();
+    if (entry.pageCache != nullptr) {
+        entry.pageCache->invalidate();
+    }
+
+    return lock.releaseAndReturn(node.writeData(sourceBuffer, pos, numBytes));
+}
+
+bool CachedNode::control(uint32_t request, const Util::Array<uint32_t> &parameters) {
+    lock.acquire();
+    if (entry.pageCache != nullptr) {
+        entry.pageCache->invalidate();
+    }
+
+    return lock.releaseAndReturn(node.control(request, parameters));
+}
+
+bool CachedNode::sync() {
+    lock.acquire();
+    return lock.releaseAndReturn(node.sync());
+}
+
+bool CachedNode::isReadaheadDue(uint64_t position) const {
+    return position + (window * PageCache::PAGE_SIZE) / 2 >= readaheadEnd;
+}
+
+void CachedNode::startReadahead(uint64_t position) {
+    auto start = readaheadEnd > position ? readaheadEnd : position;
+    auto length = node.getLength();
+    if (start >= length) {
+        return;
+    }
+
+    window = window == 0 ? MIN_READAHEAD_PAGES : window * 2;
+    if (window > ReadaheadWorker::MAX_PAGES) {
+        window = ReadaheadWorker::MAX_PAGES;
+    }
+
+    auto firstPage = static_cast<uint32_t>(start >> PageCache::PAGE_SHIFT);
+    auto lastPage = static_cast<uint32_t>((length - 1) >> PageCache::PAGE_SHIFT);
+    auto pageCount = lastPage - firstPage + 1 < window ? lastPage - firstPage + 1 : window;
+
+    readaheadEnd = static_cast<uint64_t>(firstPage + pageCount) << PageCache::PAGE_SHIFT;
+    cache.scheduleReadahead(entry, firstPage, pageCount);
+}
+
+}
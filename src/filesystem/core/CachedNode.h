@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_CACHEDNODE_H
+#define HHUOS_CACHEDNODE_H
+
+#include <cstdint>
+
+#include "filesystem/core/Node.h"
+#include "filesystem/core/NodeCache.h"
+#include "lib/util/collection/Array.h"
+#include "lib/util/base/String.h"
+#include "lib/util/io/file/File.h"
+
+namespace Util {
+namespace Async {
+class ReentrantSpinlock;
+}  // namespace Async
+}  // namespace Util
+
+namespace Filesystem {
+
+/**
+ * A reference on a node, which is shared via the NodeCache.
+ * All operations are forwarded to the cached node, while holding the lock of its mount point.
+ * Each CachedNode represents one open file, so it also tracks the access pattern for readahead:
+ * As long as reads are sequential, the next extent is read into the file's PageCache asynchronously,
+ * with a window, which grows from MIN_READAHEAD_PAGES up to ReadaheadWorker::MAX_PAGES.
+ */
+class CachedNode : public Node {
+
+public:
+    /**
+     * Constructor.
+     * The caller must already hold a reference on the entry for this node.
+     */
+    CachedNode(NodeCache &cache, NodeCache::Entry &entry, Util::Async::ReentrantSpinlock &lock);
+
+    /**
+     * Copy Constructor.
+     */
+    CachedNode(const CachedNode &copy) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    CachedNode& operator=(const CachedNode &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~CachedNode() override;
+
+    /**
+     * Overriding function from Node.
+     */
+    Util::String getName() override;
+
+    /**
+     * Overriding function from Node.
+     */
+    Util::Io::File::Type getType() override;
+
+    /**
+     * Overriding function from Node.
+     */
+    uint64_t getLength() override;
+
+    /**
+     * Overriding function from Node.
+     */
+    Util::Array<Util::String> getChildren() override;
+
+    /**
+     * Overriding function from Node.
+     */
+    uint64_t readData(uint8_t *targetBuffer, uint64_t pos, uint64_t numBytes) override;
+
+    /**
+     * Overriding function from Node.
+     */
+    uint64_t writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) override;
+
+    /**
+     * Overriding function from Node.
+     */
+    bool control(uint32_t request, const Util::Array<uint32_t> &parameters) override;
+
+    /**
+     * Overriding function from Node.
+     */
+    bool sync() override;
+
+private:
+
+    /**
+     * Check if the next readahead should be started, because the reader has consumed half of the current window.
+     */
+    [[nodiscard]] bool isReadaheadDue(uint64_t position) const;
+
+    /**
+     * Schedule readahead of the next extent after a position. Must be called while holding 'lock'.
+     */
+    void startReadahead(uint64_t position);
+
+    NodeCache &cache;
+    NodeCache::Entry &entry;
+    Node &node;
+    Util::Async::ReentrantSpinlock &lock;
+
+    // Readahead state (only used, if the entry has a page cache)
+    uint64_t nextPosition = 0;
+    uint64_t readaheadEnd = 0;
+    uint32_t window = 0;
+
+    static const constexpr uint32_t MIN_READAHEAD_PAGES = 4;
+};
+
+}
+
+#endif
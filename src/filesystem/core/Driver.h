@@ -77,6 +77,37 @@ public:
      * @return true on success
      */
     virtual bool deleteNode(const Util::String &path) = 0;
+
+    /**
+     * Check if nodes returned by this driver may be cached and shared by multiple users (see NodeCache).
+     * Operations on shared nodes are serialized by the mount point's lock, so they must never block
+     * (e.g. waiting for input) and must not depend on per-user state.
+     *
+     * @return true, if nodes may be cached
+     */
+    virtual bool isCacheable() {
+        return false;
+    }
+
+    /**
+     * Check if sequential reads from cached nodes should be accelerated by reading ahead into a page cache (see PageCache).
+     * Only useful for drivers backed by slow storage, since file data must be copied once more.
+     *
+     * @return true, if the next extent of sequentially read files should be read ahead
+     */
+    virtual bool supportsReadahead() {
+        return false;
+    }
+
+    /**
+     * Write all data, which is cached by this driver (e.g. modified files, that are still open), to the storage device.
+     * Called periodically and by the SYNC system call.
+     *
+     * @return true on success
+     */
+    virtual bool sync() {
+        return true;
+    }
 };
 
 }
@@ -23,7 +23,14 @@
 #include "Filesystem.h"
 #include "filesystem/core/Driver.h"
 #include "filesystem/core/Node.h"
+#include "filesystem/core/NodeCache.h"
+#include "filesystem/core/ReadaheadWorker.h"
+#include "filesystem/core/SyncRunnable.h"
 #include "filesystem/core/VirtualDriver.h"
+#include "kernel/process/ReadCopyUpdate.h"
+#include "kernel/process/Thread.h"
+#include "kernel/service/ProcessService.h"
+#include "kernel/service/SchedulerService.h"
 
 namespace Filesystem {
 namespace Memory {
@@ -42,11 +49,13 @@ bool Filesystem::mount(const Util::String &deviceName, const Util::String &targe
     auto parsedPath = Util::Io::File::getCanonicalPath(targetPath) + Util::Io::File::SEPARATOR;
     auto *targetNode = getNode(parsedPath);
     if (targetNode == nullptr) {
-        if (mountPoints.size() != 0) {
+        if (mountTrie != nullptr) {
             return lock.releaseAndReturn(false);
         }
     }
 
+    delete targetNode;
+
     auto &device = storageService.getDevice(deviceName);
     auto *driver = INSTANCE_FACTORY_CREATE_INSTANCE(PhysicalDriver, driverName);
     if (driver == nullptr || !driver->mount(device)) {
@@ -54,11 +63,15 @@ bool Filesystem::mount(const Util::String &deviceName, const Util::String &targe
         return lock.releaseAndReturn(false);
     }
 
-    if (mountPoints.containsKey(parsedPath)) {
+    if (getMountPointExact(parsedPath) != nullptr) {
+        delete driver;
         return lock.releaseAndReturn(false);
     }
 
-    mountPoints.put(parsedPath, driver);
+    invalidateNodes(parsedPath);
+    auto *worker = driver->supportsReadahead() ? &getReadaheadWorker() : nullptr;
+    updateMountTrie(new MountPoint(parsedPath, driver, &physicalDriverLock, false, worker), nullptr);
+    startSyncThread();
     mountInformation.put(parsedPath, {deviceName, targetPath, driverName});
     return lock.releaseAndReturn(true);
 }
@@ -70,28 +83,31 @@ bool Filesystem::mountVirtualDriver(const Util::String &targetPath, VirtualDrive
 
     auto *targetNode = getNode(parsedPath);
     if (targetNode == nullptr) {
-        if (mountPoints.size() != 0) {
+        if (mountTrie != nullptr) {
             return lock.releaseAndReturn(false);
         }
     }
 
     delete targetNode;
 
-    if (mountPoints.containsKey(parsedPath)) {
+    if (getMountPointExact(parsedPath) != nullptr) {
         return lock.releaseAndReturn(false);
     }
 
-    mountPoints.put(parsedPath, driver);
+    invalidateNodes(parsedPath);
+    updateMountTrie(new MountPoint(parsedPath, driver, new Util::Async::ReentrantSpinlock(), true, nullptr), nullptr);
     mountInformation.put(parsedPath, {"Virtual", targetPath, "VirtualDriver"});
     return lock.releaseAndReturn(true);
 }
 
 Memory::MemoryDriver& Filesystem::getVirtualDriver(const Util::String &path) {
-    lock.acquire();
     auto parsedPath = Util::Io::File::getCanonicalPath(path) + Util::Io::File::SEPARATOR;
-    auto *driver = mountPoints.get(parsedPath);
+    auto token = Kernel::ReadCopyUpdate::readLock();
+    auto *mountPoint = getMountPointExact(parsedPath);
+    auto *driver = mountPoint == nullptr ? nullptr : mountPoint->driver;
+    Kernel::ReadCopyUpdate::readUnlock(token);
 
-    return lock.releaseAndReturn<Memory::MemoryDriver&>(*reinterpret_cast<Memory::MemoryDriver*>(driver));
+    return *reinterpret_cast<Memory::MemoryDriver*>(driver);
 }
 
 bool Filesystem::unmount(const Util::String &path) {
@@ -108,21 +124,46 @@ bool Filesystem::unmount(const Util::String &path) {
 
     delete targetNode;
 
-    for(const Util::String &key : mountPoints.keys()) {
-        if(key.beginsWith(parsedPath)) {
-            if(key != parsedPath) {
-                return lock.releaseAndReturn(false);
-            }
-        }
+    // Only writers (holding 'lock') modify the mount trie, so no read section is needed here.
+    // Trie nodes only exist on the way to mount points, so a node with children has other mount points below it.
+    auto *mountNode = getMountNode(parsedPath);
+    if (mountNode == nullptr || mountNode->mountPoint == nullptr || mountNode->children.size() > 0) {
+        return lock.releaseAndReturn(false);
     }
 
-    if(mountPoints.containsKey(parsedPath)) {
-        mountInformation.remove(parsedPath);
-        delete mountPoints.remove(parsedPath);
-        return lock.releaseAndReturn(true);
+    // Cached nodes are shared and use the mount point's lock, so they must not outlive it
+    auto *mountPoint = mountNode->mountPoint;
+    mountPoint->lock->acquire();
+    if (mountPoint->cache != nullptr && mountPoint->cache->isReferenced()) {
+        mountPoint->lock->release();
+        return lock.releaseAndReturn(false);
     }
 
-    return lock.releaseAndReturn(false);
+    // Cached data must be written back now, since the driver is only deleted after a grace period
+    mountPoint->driver->sync();
+    mountPoint->mounted = false;
+    mountPoint->lock->release();
+
+    mountInformation.remove(parsedPath);
+    updateMountTrie(nullptr, mountPoint);
+    invalidateNodes(parsedPath);
+    return lock.releaseAndReturn(true);
+}
+
+bool Filesystem::sync() {
+    lock.acquire();
+
+    auto success = true;
+    for (auto *mountPoint : mountPoints) {
+        mountPoint->lock->acquire();
+        if (!mountPoint->driver->sync()) {
+            success = false;
+        }
+
+        mountPoint->lock->release();
+    }
+
+    return lock.releaseAndReturn(success);
 }
 
 bool Filesystem::createFilesystem(const Util::String &deviceName, const Util::String &driverName) {
@@ -131,98 +172,229 @@ bool Filesystem::createFilesystem(const Util::String &deviceName, const Util::St
         return false;
     }
 
-    lock.acquire();
+    physicalDriverLock.acquire();
 
     auto &device = storageService.getDevice(deviceName);
     auto *driver = INSTANCE_FACTORY_CREATE_INSTANCE(PhysicalDriver, driverName);
     auto result = driver->createFilesystem(device);
 
     delete driver;
-    return lock.releaseAndReturn(result);
+    return physicalDriverLock.releaseAndReturn(result);
 }
 
 Node* Filesystem::getNode(const Util::String &path) {
     auto parsedPath = Util::Io::File::getCanonicalPath(path);
-    lock.acquire();
+    auto token = Kernel::ReadCopyUpdate::readLock();
 
-    auto *driver = getMountedDriver(parsedPath);
-    if (driver == nullptr) {
-        return lock.releaseAndReturn(nullptr);
+    auto *mountPoint = getMountPoint(parsedPath);
+    if (mountPoint == nullptr) {
+        Kernel::ReadCopyUpdate::readUnlock(token);
+        return nullptr;
     }
 
-    Node *ret = driver->getNode(parsedPath);
-    return lock.releaseAndReturn(ret);
+    mountPoint->lock->acquire();
+    Node *ret = nullptr;
+    if (mountPoint->mounted) {
+        ret = mountPoint->cache == nullptr ? mountPoint->driver->getNode(parsedPath) : mountPoint->cache->getNode(parsedPath);
+    }
+    mountPoint->lock->release();
+
+    Kernel::ReadCopyUpdate::readUnlock(token);
+    return ret;
 }
 
 bool Filesystem::createFile(const Util::String &path) {
     auto parsedPath = Util::Io::File::getCanonicalPath(path);
-    lock.acquire();
+    auto token = Kernel::ReadCopyUpdate::readLock();
 
-    auto *driver = getMountedDriver(parsedPath);
-    if (driver == nullptr) {
-        return lock.releaseAndReturn(false);
+    auto *mountPoint = getMountPoint(parsedPath);
+    if (mountPoint == nullptr) {
+        Kernel::ReadCopyUpdate::readUnlock(token);
+        return false;
+    }
+
+    mountPoint->lock->acquire();
+    if (mountPoint->cache != nullptr) {
+        mountPoint->cache->invalidate(parsedPath);
     }
 
-    bool ret = driver->createNode(parsedPath, Util::Io::File::REGULAR);
-    return lock.releaseAndReturn(ret);
+    bool ret = mountPoint->driver->createNode(parsedPath, Util::Io::File::REGULAR);
+    mountPoint->lock->release();
+
+    Kernel::ReadCopyUpdate::readUnlock(token);
+    return ret;
 }
 
 bool Filesystem::createDirectory(const Util::String &path) {
     auto parsedPath = Util::Io::File::getCanonicalPath(path);
-    lock.acquire();
+    auto token = Kernel::ReadCopyUpdate::readLock();
 
-    auto *driver = getMountedDriver(parsedPath);
-    if (driver == nullptr) {
-        return lock.releaseAndReturn(false);
+    auto *mountPoint = getMountPoint(parsedPath);
+    if (mountPoint == nullptr) {
+        Kernel::ReadCopyUpdate::readUnlock(token);
+        return false;
     }
 
-    bool ret = driver->createNode(parsedPath, Util::Io::File::DIRECTORY);
-    return lock.releaseAndReturn(ret);
+    mountPoint->lock->acquire();
+    if (mountPoint->cache != nullptr) {
+        mountPoint->cache->invalidate(parsedPath);
+    }
+
+    bool ret = mountPoint->driver->createNode(parsedPath, Util::Io::File::DIRECTORY);
+    mountPoint->lock->release();
+
+    Kernel::ReadCopyUpdate::readUnlock(token);
+    return ret;
 }
 
 bool Filesystem::deleteFile(const Util::String &path) {
     auto parsedPath = Util::Io::File::getCanonicalPath(path);
-    lock.acquire();
+    auto token = Kernel::ReadCopyUpdate::readLock();
 
-    for (const Util::String &key : mountPoints.keys()) {
-        if (key.beginsWith(parsedPath)) {
-            lock.release();
-            return false;
-        }
+    // Mount points and the directories leading to them cannot be deleted
+    if (getMountNode(parsedPath) != nullptr) {
+        Kernel::ReadCopyUpdate::readUnlock(token);
+        return false;
     }
 
-    auto *driver = getMountedDriver(parsedPath);
-    if (driver == nullptr) {
-        return lock.releaseAndReturn(false);
+    auto *mountPoint = getMountPoint(parsedPath);
+    if (mountPoint == nullptr) {
+        Kernel::ReadCopyUpdate::readUnlock(token);
+        return false;
     }
 
-    bool ret = driver->deleteNode(parsedPath);
-    return lock.releaseAndReturn<bool>(ret);
+    // The cached node is dropped first, so that the driver does not see the file as still being open
+    mountPoint->lock->acquire();
+    if (mountPoint->cache != nullptr) {
+        mountPoint->cache->invalidate(parsedPath);
+    }
+
+    bool ret = mountPoint->driver->deleteNode(parsedPath);
+    mountPoint->lock->release();
+
+    Kernel::ReadCopyUpdate::readUnlock(token);
+    return ret;
 }
 
-Driver* Filesystem::getMountedDriver(Util::String &path) {
+Filesystem::MountPoint* Filesystem::getMountPoint(Util::String &path) const {
     if (!path.endsWith(Util::Io::File::SEPARATOR)) {
         path += Util::Io::File::SEPARATOR;
     }
 
+    auto *node = Kernel::ReadCopyUpdate::read(mountTrie);
+    if (node == nullptr) {
+        return nullptr;
+    }
 
-    lock.acquire();
+    // Walk down the trie and remember the deepest mount point on the way
+    auto *mountPoint = node->mountPoint;
+    uint32_t prefixLength = 1;
+    uint32_t currentLength = 1;
+    for (const auto &component : path.split(Util::Io::File::SEPARATOR)) {
+        MountNode *child = nullptr;
+        for (uint32_t i = 0; i < node->children.size(); i++) {
+            if (node->children.get(i)->name == component) {
+                child = node->children.get(i);
+                break;
+            }
+        }
+
+        if (child == nullptr) {
+            break;
+        }
+
+        node = child;
+        currentLength += component.length() + 1;
+        if (node->mountPoint != nullptr) {
+            mountPoint = node->mountPoint;
+            prefixLength = currentLength;
+        }
+    }
+
+    if (mountPoint != nullptr) {
+        path = path.substring(prefixLength, path.length() - 1);
+    }
+
+    return mountPoint;
+}
+
+Filesystem::MountPoint* Filesystem::getMountPointExact(const Util::String &path) const {
+    auto *node = getMountNode(path);
+    return node == nullptr ? nullptr : node->mountPoint;
+}
+
+Filesystem::MountNode* Filesystem::getMountNode(const Util::String &path) const {
+    auto *node = Kernel::ReadCopyUpdate::read(mountTrie);
+    for (const auto &component : path.split(Util::Io::File::SEPARATOR)) {
+        if (node == nullptr) {
+            return nullptr;
+        }
 
-    Util::String ret;
-    for (const Util::String &currentString: mountPoints.keys()) {
-        if (path.beginsWith(currentString)) {
-            if (currentString.length() > ret.length()) {
-                ret = currentString;
+        MountNode *child = nullptr;
+        for (uint32_t i = 0; i < node->children.size(); i++) {
+            if (node->children.get(i)->name == component) {
+                child = node->children.get(i);
+                break;
             }
         }
+
+        node = child;
+    }
+
+    return node;
+}
+
+void Filesystem::invalidateNodes(const Util::String &path) const {
+    auto relativePath = path;
+    auto *mountPoint = getMountPoint(relativePath);
+    if (mountPoint == nullptr || mountPoint->cache == nullptr) {
+        return;
+    }
+
+    mountPoint->lock->acquire();
+    mountPoint->cache->invalidate(relativePath);
+    mountPoint->lock->release();
+}
+
+void Filesystem::updateMountTrie(MountPoint *addedMountPoint, MountPoint *removedMountPoint) {
+    if (removedMountPoint != nullptr) {
+        mountPoints.remove(removedMountPoint);
+    }
+
+    if (addedMountPoint != nullptr) {
+        mountPoints.add(addedMountPoint);
     }
 
-    if (ret.isEmpty()) {
-        return lock.releaseAndReturn(nullptr);
+    MountNode *newTrie = nullptr;
+    if (mountPoints.size() > 0) {
+        newTrie = new MountNode{"", nullptr};
+        for (auto *mountPoint : mountPoints) {
+            auto *node = newTrie;
+            for (const auto &component : mountPoint->path.split(Util::Io::File::SEPARATOR)) {
+                MountNode *child = nullptr;
+                for (uint32_t i = 0; i < node->children.size(); i++) {
+                    if (node->children.get(i)->name == component) {
+                        child = node->children.get(i);
+                        break;
+                    }
+                }
+
+                if (child == nullptr) {
+                    child = new MountNode{component, nullptr};
+                    node->children.add(child);
+                }
+
+                node = child;
+            }
+
+            node->mountPoint = mountPoint;
+        }
     }
 
-    path = path.substring(ret.length(), path.length() - 1);
-    return lock.releaseAndReturn(mountPoints.get(ret));
+    auto *oldTrie = mountTrie;
+    Kernel::ReadCopyUpdate::publish(mountTrie, newTrie);
+    Kernel::ReadCopyUpdate::retire(oldTrie);
+    Kernel::ReadCopyUpdate::retire(removedMountPoint);
 }
 
 Util::Array<MountInformation> Filesystem::getMountInformation() {
@@ -230,6 +402,45 @@ Util::Array<MountInformation> Filesystem::getMountInformation() {
     return lock.releaseAndReturn(mountInformation.values());
 }
 
+ReadaheadWorker& Filesystem::getReadaheadWorker() {
+    if (readaheadWorker == nullptr) {
+        readaheadWorker = new ReadaheadWorker();
+        auto &processService = Kernel::System::getService<Kernel::ProcessService>();
+        auto &thread = Kernel::Thread::createKernelThread("Readahead", processService.getKernelProcess(), readaheadWorker);
+        Kernel::System::getService<Kernel::SchedulerService>().ready(thread);
+    }
+
+    return *readaheadWorker;
+}
+
+void Filesystem::startSyncThread() {
+    if (syncThreadStarted) {
+        return;
+    }
+
+    auto &processService = Kernel::System::getService<Kernel::ProcessService>();
+    auto &thread = Kernel::Thread::createKernelThread("Filesystem-Sync", processService.getKernelProcess(), new SyncRunnable(*this));
+    Kernel::System::getService<Kernel::SchedulerService>().ready(thread);
+    syncThreadStarted = true;
+}
+
+Filesystem::MountPoint::MountPoint(const Util::String &path, Driver *driver, Util::Async::ReentrantSpinlock *lock, bool ownsLock, ReadaheadWorker *readaheadWorker) :
+        path(path), driver(driver), lock(lock), ownsLock(ownsLock), cache(driver->isCacheable() ? new NodeCache(*driver, *lock, readaheadWorker) : nullptr) {}
+
+Filesystem::MountPoint::~MountPoint() {
+    delete cache;
+    delete driver;
+    if (ownsLock) {
+        delete lock;
+    }
+}
+
+Filesystem::MountNode::~MountNode() {
+    for (auto *child : children) {
+        delete child;
+    }
+}
+
 bool MountInformation::operator!=(const MountInformation &other) const {
     return target == other.target;
 }
@@ -20,12 +20,15 @@
 
 #include "lib/util/async/ReentrantSpinlock.h"
 #include "lib/util/collection/HashMap.h"
+#include "lib/util/collection/ArrayList.h"
 #include "lib/util/collection/Array.h"
 #include "lib/util/base/String.h"
 #include "filesystem/core/Driver.h"
 
 namespace Filesystem {
 class Node;
+class NodeCache;
+class ReadaheadWorker;
 class VirtualDriver;
 
 namespace Memory {
@@ -42,8 +45,11 @@ struct MountInformation {
 };
 
 /**
- * The filesystem. It works by maintaining a list of mount points.
+ * The filesystem. It works by maintaining a trie of mount points.
  * Every request is handled by picking the right mount point and and passing the request over to the corresponding driver.
+ * Nodes of cacheable drivers are kept in a per mount point NodeCache, so repeated lookups of the same path
+ * do not need to ask the driver again. Sequential reads from drivers, which support readahead,
+ * are served from a per file PageCache, which is filled asynchronously by a shared ReadaheadWorker.
  */
 class Filesystem {
 
@@ -99,6 +105,14 @@ public:
      */
     bool unmount(const Util::String &path);
 
+    /**
+     * Write back all data, which is cached by the drivers of all mount points.
+     * This is also done periodically by a kernel thread, which is started with the first physical mount.
+     *
+     * @return true on success
+     */
+    bool sync();
+
     /**
      * Format a device with a specified filesystem type.
      *
@@ -167,22 +181,103 @@ public:
     [[nodiscard]] Util::Array<MountInformation> getMountInformation();
     
 private:
+
+    struct MountPoint {
+        Util::String path;
+        Driver *driver;
+        Util::Async::ReentrantSpinlock *lock; // Serializes all operations on the driver
+        bool ownsLock;
+        NodeCache *cache; // Only for cacheable drivers (protected by 'lock')
+        bool mounted = true; // Protected by 'lock'
+
+        MountPoint(const Util::String &path, Driver *driver, Util::Async::ReentrantSpinlock *lock, bool ownsLock, ReadaheadWorker *readaheadWorker);
+
+        ~MountPoint();
+    };
+
     /**
-     * Get the driver, that is mounted at a specified path.
-     * The path needs to be absolute.
+     * Node of the mount trie. There is one node per path component on the way to any mount point.
+     * A trie is never modified after it has been published. Mounting or unmounting builds a new trie.
+     */
+    struct MountNode {
+        Util::String name;
+        MountPoint *mountPoint;
+        Util::ArrayList<MountNode*> children;
+
+        ~MountNode();
+    };
+
+    /**
+     * Get the mount point, whose path is the longest prefix of a specified path.
+     * This is lock-free, but must be called inside a read-copy-update read section.
      * CAUTION: May return nullptr, if the file does not exist.
      *          Always check the return value!
      *
      * @param path The path. After successful execution, the part up to the mount point will be truncated,
      *             so that the path can be used for the returned driver.
      *
-     * @return The driver (or nullptr on failure)
+     * @return The mount point (or nullptr on failure)
+     */
+    [[nodiscard]] MountPoint* getMountPoint(Util::String &path) const;
+
+    /**
+     * Get the mount point at exactly the specified path.
+     * This is lock-free, but must be called inside a read-copy-update read section or while holding 'lock'.
+     *
+     * @param path The canonical path, ending with a separator
+     *
+     * @return The mount point (or nullptr, if nothing is mounted there)
+     */
+    [[nodiscard]] MountPoint* getMountPointExact(const Util::String &path) const;
+
+    /**
+     * Get the trie node for a path. A node only exists, if the path is a mount point or leads to one.
+     * This is lock-free, but must be called inside a read-copy-update read section or while holding 'lock'.
+     *
+     * @param path The canonical path
+     *
+     * @return The node (or nullptr, if neither the path nor any path below it is a mount point)
+     */
+    [[nodiscard]] MountNode* getMountNode(const Util::String &path) const;
+
+    /**
+     * Drop all cached nodes at and below a path, which are shadowed or revealed by a mount point.
+     * Must be called while holding 'lock'.
+     */
+    void invalidateNodes(const Util::String &path) const;
+
+    /**
+     * Publish a new mount trie with a mount point added and/or removed.
+     * Must be called while holding 'lock'. The old trie and the removed mount point are reclaimed after a grace period.
+     *
+     * @param addedMountPoint The mount point to add (or nullptr)
+     * @param removedMountPoint The mount point to remove (or nullptr)
+     */
+    void updateMountTrie(MountPoint *addedMountPoint, MountPoint *removedMountPoint);
+
+    /**
+     * Get the readahead worker and start its thread, if it is not running yet.
+     * Must be called while holding 'lock'.
+     */
+    ReadaheadWorker& getReadaheadWorker();
+
+    /**
+     * Start the thread, which periodically syncs all mount points, if it is not running yet.
+     * Must be called while holding 'lock'.
      */
-    [[nodiscard]] Driver* getMountedDriver(Util::String &path);
+    void startSyncThread();
 
-    Util::HashMap<Util::String, Driver*> mountPoints;
+    // Protected by read-copy-update
+    MountNode *volatile mountTrie = nullptr;
+    // All mount points (only accessed while holding 'lock')
+    Util::ArrayList<MountPoint*> mountPoints;
     Util::HashMap<Util::String, MountInformation> mountInformation;
-    Util::Async::ReentrantSpinlock lock;
+    Util::Async::ReentrantSpinlock lock{"Filesystem"};
+    // FatFs may share work buffers between volumes, so all physical drivers are serialized by a single lock
+    Util::Async::ReentrantSpinlock physicalDriverLock{"Filesystem.physical"};
+    // Started with the first mount of a driver, that supports readahead (protected by 'lock')
+    ReadaheadWorker *readaheadWorker = nullptr;
+    bool syncThreadStarted = false;
 };
 
 }
@@ -112,6 +112,15 @@ public:
     virtual bool control(uint32_t request, const Util::Array<uint32_t> &parameters) {
         return false;
     }
+
+    /**
+     * Write all data of this node, which is cached by its driver, to the underlying storage device.
+     *
+     * @return true on success (also, if there is nothing to write)
+     */
+    virtual bool sync() {
+        return true;
+    }
 };
 
 }
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "NodeCache.h"
+
+#include "filesystem/core/CachedNode.h"
+#include "filesystem/core/Driver.h"
+#include "filesystem/core/Node.h"
+#include "filesystem/core/PageCache.h"
+#include "filesystem/core/ReadaheadWorker.h"
+#include "lib/util/async/ReentrantSpinlock.h"
+#include "lib/util/collection/Array.h"
+#include "lib/util/io/file/File.h"
+
+namespace Filesystem {
+
+NodeCache::Entry::Entry(const Util::String &name, Entry *parent) : name(name), parent(parent) {}
+
+NodeCache::Entry::~Entry() {
+    delete pageCache;
+    delete node;
+}
+
+NodeCache::NodeCache(Driver &driver, Util::Async::ReentrantSpinlock &lock, ReadaheadWorker *readaheadWorker) :
+        driver(driver), lock(lock), readaheadWorker(readaheadWorker), root("", nullptr) {}
+
+NodeCache::~NodeCache() {
+    for (auto *child : root.children.values()) {
+        detach(*child);
+    }
+}
+
+Node* NodeCache::getNode(const Util::String &path) {
+    // Every component on the path is touched, so that intermediate entries are evicted as well, once their children are gone
+    auto *entry = &root;
+    for (const auto &component : path.split(Util::Io::File::SEPARATOR)) {
+        if (entry->children.containsKey(component)) {
+            entry = entry->children.get(component);
+        } else {
+            auto *child = new Entry(component, entry);
+            entry->children.put(component, child);
+            entryCount++;
+            entry = child;
+        }
+
+        touch(*entry);
+    }
+
+    if (!entry->resolved) {
+        entry->node = driver.getNode(path);
+        entry->resolved = true;
+
+        if (readaheadWorker != nullptr && entry->node != nullptr && entry->node->getType() == Util::Io::File::REGULAR) {
+            entry->pageCache = new PageCache();
+        }
+    }
+
+    if (entry->node == nullptr) {
+        evict();
+        return nullptr;
+    }
+
+    reference(*entry);
+    evict();
+    return new CachedNode(*this, *entry, lock);
+}
+
+void NodeCache::invalidate(const Util::String &path) {
+    auto *entry = &root;
+    for (const auto &component : path.split(Util::Io::File::SEPARATOR)) {
+        if (!entry->children.containsKey(component)) {
+            return;
+        }
+
+        entry = entry->children.get(component);
+    }
+
+    if (entry == &root) {
+        for (auto *child : root.children.values()) {
+            detach(*child);
+        }
+
+        return;
+    }
+
+    detach(*entry);
+}
+
+void NodeCache::release(Entry &entry) {
+    if (--entry.references > 0) {
+        return;
+    }
+
+    // The node stays cached, so data written by the last user is written back now (like closing the file)
+    referencedEntries--;
+    entry.node->sync();
+    if (entry.detached) {
+        delete &entry;
+    }
+}
+
+bool NodeCache::isReferenced() const {
+    return referencedEntries > 0;
+}
+
+void NodeCache::scheduleReadahead(Entry &entry, uint32_t firstPage, uint32_t pageCount) {
+    if (pageCount > ReadaheadWorker::MAX_PAGES) {
+        pageCount = ReadaheadWorker::MAX_PAGES;
+    }
+
+    // Skip pages at the beginning of the range, which are already cached or in flight.
+    // Pages further in the range are read anyway (completing a page, which has not been reserved, is a no-op).
+    auto &pageCache = *entry.pageCache;
+    while (pageCount > 0 && !pageCache.reserve(firstPage)) {
+        firstPage++;
+        pageCount--;
+    }
+
+    if (pageCount == 0) {
+        return;
+    }
+
+    for (uint32_t i = 1; i < pageCount; i++) {
+        pageCache.reserve(firstPage + i);
+    }
+
+    reference(entry);
+    if (!readaheadWorker->schedule(*this, entry, firstPage, pageCount)) {
+        // Queue is full -> Drop the reservations, so that readers do not wait for them
+        auto generation = pageCache.getGeneration();
+        for (uint32_t i = 0; i < pageCount; i++) {
+            pageCache.complete(firstPage + i, nullptr, 0, generation);
+        }
+
+        release(entry);
+    }
+}
+
+void NodeCache::readAhead(Entry &entry, uint32_t firstPage, uint32_t pageCount, uint8_t *buffer) {
+    auto &pageCache = *entry.pageCache;
+
+    // The generation must be obtained while holding the lock, so that a concurrent write invalidates the data read here
+    lock.acquire();
+    auto generation = pageCache.getGeneration();
+    uint64_t length = 0;
+    if (!entry.detached) {
+        length = entry.node->readData(buffer, static_cast<uint64_t>(firstPage) << PageCache::PAGE_SHIFT, pageCount * PageCache::PAGE_SIZE);
+    }
+    lock.release();
+
+    for (uint32_t i = 0; i < pageCount; i++) {
+        auto offset = i * PageCache::PAGE_SIZE;
+        auto pageLength = length > offset ? static_cast<uint32_t>(length - offset) : 0;
+        if (pageLength > PageCache::PAGE_SIZE) {
+            pageLength = PageCache::PAGE_SIZE;
+        }
+
+        pageCache.complete(firstPage + i, buffer + offset, pageLength, generation);
+    }
+
+    lock.acquire();
+    release(entry);
+    lock.release();
+}
+
+void NodeCache::reference(Entry &entry) {
+    if (entry.references++ == 0) {
+        referencedEntries++;
+    }
+}
+
+void NodeCache::touch(Entry &entry) {
+    if (mostRecentlyUsed == &entry) {
+        return;
+    }
+
+    if (entry.previous != nullptr || entry.next != nullptr || leastRecentlyUsed == &entry) {
+        unlink(entry);
+    }
+
+    entry.previous = mostRecentlyUsed;
+    entry.next = nullptr;
+    if (mostRecentlyUsed != nullptr) {
+        mostRecentlyUsed->next = &entry;
+    } else {
+        leastRecentlyUsed = &entry;
+    }
+
+    mostRecentlyUsed = &entry;
+}
+
+void NodeCache::unlink(Entry &entry) {
+    if (entry.previous != nullptr) {
+        entry.previous->next = entry.next;
+    } else if (leastRecentlyUsed == &entry) {
+        leastRecentlyUsed = entry.next;
+    }
+
+    if (entry.next != nullptr) {
+        entry.next->previous = entry.previous;
+    } else if (mostRecentlyUsed == &entry) {
+        mostRecentlyUsed = entry.previous;
+    }
+
+    entry.previous = nullptr;
+    entry.next = nullptr;
+}
+
+void NodeCache::detach(Entry &entry) {
+    for (auto *child : entry.children.values()) {
+        detach(*child);
+    }
+
+    if (entry.parent != nullptr) {
+        entry.parent->children.remove(entry.name);
+        entry.parent = nullptr;
+    }
+
+    unlink(entry);
+    entryCount--;
+
+    // Referenced entries stay alive, until the last CachedNode using them is deleted
+    if (entry.references > 0) {
+        entry.detached = true;
+        return;
+    }
+
+    delete &entry;
+}
+
+void NodeCache::evict() {
+    // Only leaves can be evicted, since an entry's path components must stay in the tree
+    auto *entry = leastRecentlyUsed;
+    while (entryCount > MAX_ENTRIES && entry != nullptr) {
+        if (entry->references == 0 && entry->children.size() == 0) {
+            // Evicting an entry may turn its parent into a leaf, so start over with the least recently used entry
+            detach(*entry);
+            entry = leastRecentlyUsed;
+            continue;
+        }
+
+        entry = entry->next;
+    }
+}
+
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_NODECACHE_H
+#define HHUOS_NODECACHE_H
+
+#include <cstdint>
+
+#include "lib/util/base/String.h"
+#include "lib/util/collection/HashMap.h"
+
+namespace Util {
+namespace Async {
+class ReentrantSpinlock;
+}  // namespace Async
+}  // namespace Util
+
+namespace Filesystem {
+class Driver;
+class Node;
+class PageCache;
+class ReadaheadWorker;
+
+/**
+ * Cache for the nodes of a single mount point, organized as a tree of path components (similar to a dentry cache).
+ * Every lookup walks the tree component by component and only asks the driver for a node, if the path has not
+ * been resolved before. Paths, which do not exist, are cached as well (negative entries).
+ *
+ * Nodes are shared by all users of a path: getNode() returns a CachedNode, which holds a reference
+ * on the cached node and forwards all operations to it, while holding the mount point's lock.
+ * Unreferenced entries are evicted in least recently used order, once the cache exceeds MAX_ENTRIES.
+ * Releasing the last reference on an entry syncs its node, since this corresponds to closing the file.
+ * Invalidated entries, which are still referenced, are detached from the tree and freed with their last reference.
+ * If a readahead worker is given, regular files get a PageCache, which is filled asynchronously (see CachedNode::readData()).
+ *
+ * All functions must be called while holding the mount point's lock.
+ */
+class NodeCache {
+
+public:
+
+    struct Entry {
+        Util::String name;
+        Entry *parent;
+        Util::HashMap<Util::String, Entry*> children;
+        Node *node = nullptr;
+        PageCache *pageCache = nullptr;
+        bool resolved = false;
+        bool detached = false;
+        uint32_t references = 0;
+        // Least recently used list
+        Entry *previous = nullptr;
+        Entry *next = nullptr;
+
+        Entry(const Util::String &name, Entry *parent);
+
+        ~Entry();
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param driver The driver of the mount point
+     * @param lock The lock, which serializes all operations on the driver
+     * @param readaheadWorker The worker for asynchronous readahead (or nullptr, to disable readahead)
+     */
+    NodeCache(Driver &driver, Util::Async::ReentrantSpinlock &lock, ReadaheadWorker *readaheadWorker);
+
+    /**
+     * Copy Constructor.
+     */
+    NodeCache(const NodeCache &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    NodeCache &operator=(const NodeCache &other) = delete;
+
+    /**
+     * Destructor.
+     * No cached node may be referenced anymore.
+     */
+    ~NodeCache();
+
+    /**
+     * Get a node, relative to the mount point.
+     *
+     * @param path The path, relative to the mount point
+     *
+     * @return A new reference on the node (or nullptr, if the path does not exist)
+     */
+    Node* getNode(const Util::String &path);
+
+    /**
+     * Drop the cached entry of a path and all entries below it.
+     * Must be called after the path has been created or deleted.
+     *
+     * @param path The path, relative to the mount point
+     */
+    void invalidate(const Util::String &path);
+
+    /**
+     * Release a reference on an entry (called when a CachedNode is deleted).
+     */
+    void release(Entry &entry);
+
+    /**
+     * Check if any cached node is still referenced.
+     */
+    [[nodiscard]] bool isReferenced() const;
+
+    /**
+     * Start reading pages of a file into its page cache asynchronously.
+     * Pages, which are already cached or in flight, are skipped at the beginning of the range.
+     *
+     * @param entry The entry of the file (must have a page cache)
+     * @param firstPage The index of the first page
+     * @param pageCount The amount of pages (limited to ReadaheadWorker::MAX_PAGES)
+     */
+    void scheduleReadahead(Entry &entry, uint32_t firstPage, uint32_t pageCount);
+
+    /**
+     * Read pages, which have been reserved by scheduleReadahead(), into the page cache and release the request's reference.
+     * Called by the readahead worker without holding the lock.
+     *
+     * @param buffer A buffer, which is large enough to hold 'pageCount' pages
+     */
+    void readAhead(Entry &entry, uint32_t firstPage, uint32_t pageCount, uint8_t *buffer);
+
+    static const constexpr uint32_t MAX_ENTRIES = 256;
+
+private:
+
+    void reference(Entry &entry);
+
+    void touch(Entry &entry);
+
+    void unlink(Entry &entry);
+
+    void detach(Entry &entry);
+
+    void evict();
+
+    Driver &driver;
+    Util::Async::ReentrantSpinlock &lock;
+    ReadaheadWorker *readaheadWorker;
+    Entry root;
+    Entry *leastRecentlyUsed = nullptr;
+    Entry *mostRecentlyUsed = nullptr;
+    uint32_t entryCount = 0;
+    uint32_t referencedEntries = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "PageCache.h"
+
+#include "lib/util/async/Thread.h"
+#include "lib/util/base/Address.h"
+
+namespace Filesystem {
+
+PageCache::~PageCache() {
+    for (auto &slot : slots) {
+        delete[] slot.data;
+    }
+}
+
+uint64_t PageCache::read(uint8_t *targetBuffer, uint64_t pos, uint64_t numBytes) {
+    uint64_t copied = 0;
+    while (copied < numBytes) {
+        auto current = pos + copied;
+        auto page = static_cast<uint32_t>(current >> PAGE_SHIFT);
+        auto offset = static_cast<uint32_t>(current & (PAGE_SIZE - 1));
+
+        lock.acquire();
+        auto *slot = findSlot(page);
+        if (slot == nullptr || (slot->state == READY && offset >= slot->length)) {
+            lock.release();
+            break;
+        }
+
+        if (slot->state == LOADING) {
+            // The page is in flight -> Wait for the readahead to complete it, instead of reading it again
+            lock.release();
+            Util::Async::Thread::yield();
+            continue;
+        }
+
+        auto count = slot->length - offset;
+        if (count > numBytes - copied) {
+            count = numBytes - copied;
+        }
+
+        auto targetAddress = Util::Address<uint32_t>(targetBuffer + copied);
+        targetAddress.copyRange(Util::Address<uint32_t>(slot->data + offset), count);
+        slot->lastAccess = ++accessCounter;
+        lock.release();
+
+        copied += count;
+    }
+
+    return copied;
+}
+
+bool PageCache::reserve(uint32_t page) {
+    lock.acquire();
+    if (findSlot(page) != nullptr) {
+        return lock.releaseAndReturn(false);
+    }
+
+    // Use a free slot, or evict the least recently used page (pages in flight are never evicted)
+    Slot *victim = nullptr;
+    for (auto &slot : slots) {
+        if (slot.state == FREE) {
+            victim = &slot;
+            break;
+        }
+
+        if (slot.state == READY && (victim == nullptr || slot.lastAccess < victim->lastAccess)) {
+            victim = &slot;
+        }
+    }
+
+    if (victim == nullptr) {
+        return lock.releaseAndReturn(false);
+    }
+
+    if (victim->data == nullptr) {
+        victim->data = new uint8_t[PAGE_SIZE];
+    }
+
+    victim->page = page;
+    victim->length = 0;
+    victim->state = LOADING;
+    return lock.releaseAndReturn(true);
+}
+
+void PageCache::complete(uint32_t page, const uint8_t *sourceBuffer, uint32_t length, uint32_t generation) {
+    lock.acquire();
+    auto *slot = findSlot(page);
+    if (slot == nullptr || slot->state != LOADING) {
+        lock.release();
+        return;
+    }
+
+    if (length == 0 || generation != PageCache::generation) {
+        slot->state = FREE;
+        lock.release();
+        return;
+    }
+
+    auto targetAddress = Util::Address<uint32_t>(slot->data);
+    targetAddress.copyRange(Util::Address<uint32_t>(sourceBuffer), length);
+    slot->length = length;
+    slot->lastAccess = ++accessCounter;
+    slot->state = READY;
+    lock.release();
+}
+
+void PageCache::invalidate() {
+    lock.acquire();
+    generation++;
+    for (auto &slot : slots) {
+        if (slot.state == READY) {
+            slot.state = FREE;
+        }
+    }
+
+    lock.release();
+}
+
+uint32_t PageCache::getGeneration() {
+    lock.acquire();
+    return lock.releaseAndReturn(generation);
+}
+
+PageCache::Slot* PageCache::findSlot(uint32_t page) {
+    for (auto &slot : slots) {
+        if (slot.state != FREE && slot.page == page) {
+            return &slot;
+        }
+    }
+
+    return nullptr;
+}
+
+}
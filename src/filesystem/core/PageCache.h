@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_PAGECACHE_H
+#define HHUOS_PAGECACHE_H
+
+#include <cstdint>
+
+#include "lib/util/async/Spinlock.h"
+
+namespace Filesystem {
+
+/**
+ * Cache for the data of a single file, organized in page sized blocks, which are filled by readahead (see ReadaheadWorker).
+ * Pages are reserved before the I/O is started, so that readers wait for pages that are in flight instead of reading them again.
+ * Every write to the file invalidates the cache. Pages, which have been read before an invalidation, are dropped on completion.
+ *
+ * The cache has its own lock, so that cached data can be read while the mount point's lock is held by a running readahead.
+ * Lock order: The mount point's lock must be acquired before the page cache's lock.
+ */
+class PageCache {
+
+public:
+    /**
+     * Default Constructor.
+     */
+    PageCache() = default;
+
+    /**
+     * Copy Constructor.
+     */
+    PageCache(const PageCache &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    PageCache &operator=(const PageCache &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~PageCache();
+
+    /**
+     * Copy cached data to a buffer. Copying stops at the first page, which is not cached,
+     * or at the end of the file (a page that is only partially filled).
+     *
+     * @param targetBuffer The buffer to copy the data to
+     * @param pos The offset in the file
+     * @param numBytes The amount of bytes to copy
+     *
+     * @return The amount of bytes copied
+     */
+    uint64_t read(uint8_t *targetBuffer, uint64_t pos, uint64_t numBytes);
+
+    /**
+     * Reserve a slot for a page, which is going to be read.
+     *
+     * @param page The index of the page in the file
+     *
+     * @return true, if the page has been reserved (false, if it is already cached, in flight, or no slot is available)
+     */
+    bool reserve(uint32_t page);
+
+    /**
+     * Fill a reserved page. The data is dropped, if the cache has been invalidated since 'generation' has been obtained.
+     *
+     * @param page The index of the page in the file
+     * @param sourceBuffer The data of the page
+     * @param length The amount of valid bytes (less than PAGE_SIZE at the end of the file, 0 releases the reservation)
+     * @param generation The generation, at which the data has been read
+     */
+    void complete(uint32_t page, const uint8_t *sourceBuffer, uint32_t length, uint32_t generation);
+
+    /**
+     * Drop all cached pages. Pages, which are in flight, are dropped on completion.
+     * Must be called while holding the mount point's lock, before the file is modified.
+     */
+    void invalidate();
+
+    /**
+     * Get the current generation, which is incremented by every invalidation.
+     * Must be called while holding the mount point's lock, before the data to cache is read.
+     */
+    [[nodiscard]] uint32_t getGeneration();
+
+    static const constexpr uint32_t PAGE_SHIFT = 12;
+    static const constexpr uint32_t PAGE_SIZE = 1 << PAGE_SHIFT;
+    static const constexpr uint32_t MAX_PAGES = 32;
+
+private:
+
+    enum State : uint8_t {
+        FREE,
+        LOADING,
+        READY
+    };
+
+    struct Slot {
+        uint32_t page = 0;
+        uint32_t length = 0;
+        uint32_t lastAccess = 0;
+        State state = FREE;
+        uint8_t *data = nullptr;
+    };
+
+    Slot* findSlot(uint32_t page);
+
+    Slot slots[MAX_PAGES]{};
+    uint32_t accessCounter = 0;
+    uint32_t generation = 0;
+    Util::Async::Spinlock lock;
+};
+
+}
+
+#endif
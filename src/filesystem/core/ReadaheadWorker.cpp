@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "ReadaheadWorker.h"
+
+#include "filesystem/core/PageCache.h"
+#include "kernel/system/System.h"
+#include "kernel/process/Thread.h"
+#include "kernel/service/SchedulerService.h"
+
+namespace Filesystem {
+
+ReadaheadWorker::ReadaheadWorker() : queue(QUEUE_SIZE), buffer(new uint8_t[MAX_PAGES * PageCache::PAGE_SIZE]) {}
+
+ReadaheadWorker::~ReadaheadWorker() {
+    delete[] buffer;
+}
+
+bool ReadaheadWorker::schedule(NodeCache &cache, NodeCache::Entry &entry, uint32_t firstPage, uint32_t pageCount) {
+    auto *request = new Request{&cache, &entry, firstPage, pageCount};
+
+    queueLock.acquire();
+    if (!queue.offer(request)) {
+        queueLock.release();
+        delete request;
+        return false;
+    }
+
+    // Only the first request after the worker has gone to sleep needs to wake it up
+    auto wakeup = waiting;
+    waiting = false;
+    queueLock.release();
+
+    if (wakeup) {
+        Kernel::System::getService<Kernel::SchedulerService>().unblock(*workerThread);
+    }
+
+    return true;
+}
+
+void ReadaheadWorker::run() {
+    auto &schedulerService = Kernel::System::getService<Kernel::SchedulerService>();
+    workerThread = &schedulerService.getCurrentThread();
+
+    while (true) {
+        queueLock.acquire();
+        if (queue.isEmpty()) {
+            // If schedule() unblocks us before we are blocked, we are still in the ready queue afterwards and just check again
+            waiting = true;
+            queueLock.release();
+            schedulerService.block();
+            continue;
+        }
+
+        auto *request = queue.poll();
+        queueLock.release();
+
+        request->cache->readAhead(*request->entry, request->firstPage, request->pageCount, buffer);
+        delete request;
+    }
+}
+
+}
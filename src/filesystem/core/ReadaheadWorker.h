@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_READAHEADWORKER_H
+#define HHUOS_READAHEADWORKER_H
+
+#include <cstdint>
+
+#include "filesystem/core/NodeCache.h"
+#include "lib/util/async/Runnable.h"
+#include "lib/util/async/Spinlock.h"
+#include "lib/util/collection/ArrayBlockingQueue.h"
+
+namespace Kernel {
+class Thread;
+}  // namespace Kernel
+
+namespace Filesystem {
+
+/**
+ * Kernel thread, which reads extents of sequentially read files into their page caches (see PageCache),
+ * while the reader is still consuming the previous extent. Requests are scheduled by CachedNode.
+ * Each request holds a reference on its NodeCache entry, so the file cannot be evicted or unmounted while it is queued.
+ * While the queue is empty, the worker is blocked and the next call of schedule() unblocks it.
+ */
+class ReadaheadWorker : public Util::Async::Runnable {
+
+public:
+    /**
+     * Default Constructor.
+     */
+    ReadaheadWorker();
+
+    /**
+     * Copy Constructor.
+     */
+    ReadaheadWorker(const ReadaheadWorker &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    ReadaheadWorker &operator=(const ReadaheadWorker &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~ReadaheadWorker() override;
+
+    /**
+     * Queue a readahead request of at most MAX_PAGES pages. The pages must already be reserved in the entry's
+     * page cache and the caller must hold a reference on the entry, which is released by the worker.
+     *
+     * @return false, if the queue is full
+     */
+    bool schedule(NodeCache &cache, NodeCache::Entry &entry, uint32_t firstPage, uint32_t pageCount);
+
+    void run() override;
+
+    static const constexpr uint32_t MAX_PAGES = 16;
+
+private:
+
+    struct Request {
+        NodeCache *cache;
+        NodeCache::Entry *entry;
+        uint32_t firstPage;
+        uint32_t pageCount;
+    };
+
+    Util::ArrayBlockingQueue<Request*> queue;
+    Util::Async::Spinlock queueLock;
+    uint8_t *buffer;
+
+    Kernel::Thread *workerThread = nullptr;
+    bool waiting = false; // Protected by queueLock
+
+    static const constexpr uint32_t QUEUE_SIZE = 64;
+};
+
+}
+
+#endif
@@ -15,40 +15,53 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>
  */
 
-#ifndef HHUOS_ADDRESSSPACECLEANER_H
-#define HHUOS_ADDRESSSPACECLEANER_H
+#ifndef HHUOS_SYNCRUNNABLE_H
+#define HHUOS_SYNCRUNNABLE_H
+
+#include <cstdint>
 
 #include "lib/util/async/Runnable.h"
 
-namespace Kernel {
+namespace Filesystem {
+
+class Filesystem;
 
-class AddressSpaceCleaner : public Util::Async::Runnable {
+/**
+ * Periodically writes back data, which is cached by the drivers of all mount points (see Filesystem::sync()),
+ * so that modified files do not stay dirty indefinitely, while they are kept open.
+ */
+class SyncRunnable : public Util::Async::Runnable {
 
 public:
     /**
-     * Default Constructor.
+     * Constructor.
      */
-    AddressSpaceCleaner() = default;
+    explicit SyncRunnable(Filesystem &filesystem);
 
     /**
      * Copy Constructor.
      */
-    AddressSpaceCleaner(const AddressSpaceCleaner &other) = delete;
+    SyncRunnable(const SyncRunnable &other) = delete;
 
     /**
      * Assignment operator.
      */
-    AddressSpaceCleaner &operator=(const AddressSpaceCleaner &other) = delete;
+    SyncRunnable &operator=(const SyncRunnable &other) = delete;
 
     /**
      * Destructor.
      */
-    ~AddressSpaceCleaner() override = default;
+    ~SyncRunnable() override = default;
 
     void run() override;
 
+    static const constexpr uint32_t SYNC_INTERVAL = 5000;
+
+private:
+
+    Filesystem &filesystem;
 };
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -80,7 +80,7 @@ bool FatDriver::createFilesystem(Device::Storage::StorageDevice &device) {
 
 Node* FatDriver::getNode(const Util::String &path) {
     auto fatPath = Util::String::format("%u:%s", volumeId, static_cast<const char*>(path));
-    return FatNode::open(fatPath);
+    return FatNode::open(fatPath, *this);
 }
 
 bool FatDriver::createNode(const Util::String &path, Util::Io::File::Type type) {
@@ -109,4 +109,31 @@ bool FatDriver::deleteNode(const Util::String &path) {
     return result == FR_OK;
 }
 
+bool FatDriver::isCacheable() {
+    return true;
+}
+
+bool FatDriver::supportsReadahead() {
+    return true;
+}
+
+bool FatDriver::sync() {
+    auto success = true;
+    for (auto *file : openFiles) {
+        if (f_sync(file) != FR_OK) {
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+void FatDriver::registerFile(FIL &file) {
+    openFiles.add(&file);
+}
+
+void FatDriver::unregisterFile(FIL &file) {
+    openFiles.remove(&file);
+}
+
 }
\ No newline at end of file
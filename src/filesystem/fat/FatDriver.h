@@ -23,6 +23,7 @@
 #include "filesystem/fat/ff/source/ff.h"
 #include "filesystem/core/PhysicalDriver.h"
 #include "lib/util/base/String.h"
+#include "lib/util/collection/ArrayList.h"
 #include "lib/util/reflection/Prototype.h"
 #include "lib/util/io/file/File.h"
 
@@ -97,12 +98,39 @@ public:
      */
     bool deleteNode(const Util::String &path) override;
 
+    /**
+     * Overriding function from Driver.
+     */
+    bool isCacheable() override;
+
+    /**
+     * Overriding function from Driver.
+     */
+    bool supportsReadahead() override;
+
+    /**
+     * Overriding function from Driver.
+     * Syncs all open files, which also writes back the volume's FAT and directory sectors.
+     */
+    bool sync() override;
+
+    /**
+     * Register an open file, so that it is synced by sync() (called by FatFile).
+     */
+    void registerFile(FIL &file);
+
+    /**
+     * Unregister a file, before it is closed (called by FatFile).
+     */
+    void unregisterFile(FIL &file);
+
     static Device::Storage::StorageDevice& getStorageDevice(uint8_t volumeId);
 
 private:
 
     uint32_t volumeId{};
     FATFS fatVolume{};
+    Util::ArrayList<FIL*> openFiles;
 
     static Util::Async::AtomicBitmap volumeIdAllocator;
     static Util::Array<Device::Storage::StorageDevice*> deviceMap;
@@ -17,14 +17,20 @@
 
 #include "FatFile.h"
 
+#include "filesystem/fat/FatDriver.h"
 #include "filesystem/fat/FatNode.h"
 #include "lib/util/base/String.h"
 
 namespace Filesystem::Fat {
 
-FatFile::FatFile(FIL *file, FILINFO *info) : FatNode(info), file(file) {}
+FatFile::FatFile(FIL *file, FILINFO *info, FatDriver &driver) : FatNode(info), file(file), driver(driver) {
+    driver.registerFile(*file);
+}
 
 FatFile::~FatFile() {
+    // Closing the file writes back any pending data
+    driver.unregisterFile(*file);
+    f_close(file);
     delete file;
 }
 
@@ -32,18 +38,21 @@ Util::Io::File::Type FatFile::getType() {
     return Util::Io::File::REGULAR;
 }
 
+uint64_t FatFile::getLength() {
+    return f_size(file);
+}
+
 Util::Array<Util::String> FatFile::getChildren() {
     return Util::Array<Util::String>(0);
 }
 
 uint64_t FatFile::readData(uint8_t *targetBuffer, uint64_t pos, uint64_t numBytes) {
-    auto result = f_lseek(file, pos);
-    if (result != FR_OK) {
+    if (!seek(pos)) {
         return 0;
     }
 
     uint32_t readBytes;
-    result = f_read(file, targetBuffer, numBytes, &readBytes);
+    auto result = f_read(file, targetBuffer, numBytes, &readBytes);
     if (result != FR_OK) {
         return 0;
     }
@@ -52,19 +61,30 @@ uint64_t FatFile::readData(uint8_t *targetBuffer, uint64_t pos, uint64_t numByte
 }
 
 uint64_t FatFile::writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) {
-    auto result = f_lseek(file, pos);
-    if (result != FR_OK) {
+    if (!seek(pos)) {
         return 0;
     }
 
     uint32_t writtenBytes;
-    result = f_write(file, sourceBuffer, numBytes, &writtenBytes);
+    auto result = f_write(file, sourceBuffer, numBytes, &writtenBytes);
     if (result != FR_OK) {
         return 0;
     }
 
-    f_sync(file);
     return writtenBytes;
 }
 
+bool FatFile::sync() {
+    return f_sync(file) == FR_OK;
+}
+
+bool FatFile::seek(uint64_t pos) {
+    // Sequential accesses continue at the current position, so there is no need to locate the cluster again
+    if (f_tell(file) == pos) {
+        return true;
+    }
+
+    return f_lseek(file, pos) == FR_OK;
+}
+
 }
\ No newline at end of file
@@ -33,13 +33,19 @@ class String;
 
 namespace Filesystem::Fat {
 
+class FatDriver;
+
+/**
+ * A regular file on a FAT volume. Writes are not synced immediately, but stay in FatFs' buffers,
+ * until the file is synced (see sync() and FatDriver::sync()) or closed.
+ */
 class FatFile : public FatNode {
 
 public:
     /**
      * Constructor.
      */
-    FatFile(FIL *file, FILINFO *info);
+    FatFile(FIL *file, FILINFO *info, FatDriver &driver);
 
     /**
      * Copy Constructor.
@@ -61,6 +67,12 @@ public:
      */
     Util::Io::File::Type getType() override;
 
+    /**
+     * Overriding function from Node.
+     * The length is taken from the open file object, so that writes through this node are reflected.
+     */
+    uint64_t getLength() override;
+
     /**
      * Overriding function from Node.
      */
@@ -76,9 +88,20 @@ public:
      */
     uint64_t writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) override;
 
+    /**
+     * Overriding function from Node.
+     */
+    bool sync() override;
+
 private:
 
+    /**
+     * Move the file pointer, if it is not already at the requested position.
+     */
+    bool seek(uint64_t pos);
+
     FIL *file;
+    FatDriver &driver;
 };
 
 }
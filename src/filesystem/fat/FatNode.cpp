@@ -28,7 +28,7 @@ FatNode::~FatNode() {
     delete &info;
 }
 
-FatNode *FatNode::open(const Util::String &path) {
+FatNode *FatNode::open(const Util::String &path, FatDriver &driver) {
     // Try to stat the file. If this fails, the file is either non-existent,
     // or it may be the root-directory (f_stat will fail, when executed on the root-directory).
     auto *info = new FILINFO();
@@ -55,7 +55,7 @@ FatNode *FatNode::open(const Util::String &path) {
         result = f_open(file, static_cast<const char*>(path), FA_READ | FA_WRITE);
 
         if (result == FR_OK) {
-            return new FatFile(file, info);
+            return new FatFile(file, info, driver);
         }
     }
 
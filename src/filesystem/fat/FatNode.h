@@ -26,6 +26,8 @@
 
 namespace Filesystem::Fat {
 
+class FatDriver;
+
 class FatNode : public Node {
 
 public:
@@ -44,7 +46,15 @@ public:
      */
     ~FatNode() override;
 
-    static FatNode* open(const Util::String &path);
+    /**
+     * Open a file or directory.
+     *
+     * @param path The path, including the volume prefix
+     * @param driver The driver of the volume, which keeps track of open files
+     *
+     * @return The node (or nullptr, if the path does not exist)
+     */
+    static FatNode* open(const Util::String &path, FatDriver &driver);
 
     /**
      * Overriding function from Node.
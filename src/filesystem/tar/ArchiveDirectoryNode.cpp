@@ -5,26 +5,13 @@
 
 namespace Filesystem::Tar {
 
-ArchiveDirectoryNode::ArchiveDirectoryNode(Util::Io::Tar::Archive &archive, const Util::String &path) {
+ArchiveDirectoryNode::ArchiveDirectoryNode(Util::Io::Tar::Archive &archive, const Util::String &path) : children(archive.getChildren(path)) {
     if(path.isEmpty() || path == "/") {
         name = "/";
     } else {
         Util::Array<Util::String> tokens = path.split("/");
         name = tokens[tokens.length() - 1];
     }
-
-    for(const auto &header : archive.getFileHeaders()) {
-        Util::String fullPath = header.filename;
-
-        if(fullPath.beginsWith(path) && fullPath != path) {
-            Util::String subPath = fullPath.substring(path.length(), fullPath.length());
-            Util::String childName = subPath.split("/")[0];
-
-            if(!children.contains(childName)) {
-                children.add(childName);
-            }
-        }
-    }
 }
 
 Util::String ArchiveDirectoryNode::getName() {
@@ -40,7 +27,7 @@ uint64_t ArchiveDirectoryNode::getLength() {
 }
 
 Util::Array<Util::String> ArchiveDirectoryNode::getChildren() {
-    return children.toArray();
+    return children;
 }
 
 uint64_t ArchiveDirectoryNode::readData(uint8_t *targetBuffer, uint64_t pos, uint64_t numBytes) {
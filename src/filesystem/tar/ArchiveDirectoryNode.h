@@ -5,7 +5,6 @@
 
 #include "ArchiveNode.h"
 #include "lib/util/collection/Array.h"
-#include "lib/util/collection/ArrayList.h"
 #include "lib/util/base/String.h"
 #include "lib/util/io/file/File.h"
 
@@ -75,7 +74,7 @@ public:
 private:
 
     Util::String name;
-    Util::ArrayList<Util::String> children;
+    Util::Array<Util::String> children;
 
 };
 
@@ -70,10 +70,14 @@ public:
      */
     bool deleteNode(const Util::String &path) override;
 
+    /**
+     * Overriding virtual function from VirtualDriver.
+     */
+    bool isCacheable() override;
+
 private:
 
     Util::Io::Tar::Archive &archive;
-    Util::Array<Util::Io::Tar::Archive::Header> fileHeaders{};
 
 };
 
@@ -1,5 +1,7 @@
 #include "ArchiveFileNode.h"
 
+#include "lib/util/io/file/lz4/Frame.h"
+
 namespace Filesystem::Tar {
 
 ArchiveFileNode::ArchiveFileNode(Util::Io::Tar::Archive &archive, Util::Io::Tar::Archive::Header fileHeader) {
@@ -10,7 +12,17 @@ ArchiveFileNode::ArchiveFileNode(Util::Io::Tar::Archive &archive, Util::Io::Tar:
     }
 
     length = Util::Io::Tar::Archive::calculateFileSize(fileHeader);
-    dataAddress = Util::Address<uint32_t>(archive.getFile(path));
+    auto *data = archive.getFile(path);
+    dataAddress = Util::Address<uint32_t>(data);
+
+    if (data != nullptr && Util::Io::Lz4::Frame::isSupported(data, length)) {
+        frame = new Util::Io::Lz4::Frame(data, length);
+        length = frame->getContentSize();
+    }
+}
+
+ArchiveFileNode::~ArchiveFileNode() {
+    delete frame;
 }
 
 Util::String ArchiveFileNode::getName() {
@@ -43,7 +55,12 @@ uint64_t ArchiveFileNode::readData(uint8_t *targetBuffer, uint64_t pos, uint64_t
     }
 
     auto targetAddress = Util::Address<uint32_t>(targetBuffer);
-    targetAddress.copyRange(dataAddress.add(pos), numBytes);
+    if (frame != nullptr) {
+        auto *content = frame->decode(static_cast<uint32_t>(pos + numBytes));
+        targetAddress.copyRange(Util::Address<uint32_t>(content + pos), numBytes);
+    } else {
+        targetAddress.copyRange(dataAddress.add(pos), numBytes);
+    }
 
     return numBytes;
 }
@@ -10,8 +10,17 @@
 #include "lib/util/base/String.h"
 #include "lib/util/io/file/File.h"
 
+namespace Util::Io::Lz4 {
+class Frame;
+}  // namespace Util::Io::Lz4
+
 namespace Filesystem::Tar {
 
+/**
+ * A regular file in a tar archive. Files, which are stored as LZ4 frames (see Util::Io::Lz4::Frame),
+ * are decompressed transparently: Blocks are decoded on demand, when they are read for the first time,
+ * and the decompressed content is kept as long as the node exists (i.e. while it is held by the NodeCache).
+ */
 class ArchiveFileNode : public ArchiveNode {
 
 public:
@@ -33,7 +42,7 @@ public:
     /**
      * Destructor.
      */
-    ~ArchiveFileNode() override = default;
+    ~ArchiveFileNode() override;
 
     /**
      * Overriding function from Node.
@@ -69,6 +78,7 @@ private:
 
     uint32_t length = 0;
     Util::Address<uint32_t> dataAddress;
+    Util::Io::Lz4::Frame *frame = nullptr;
     Util::String name;
 };
 
@@ -8,13 +8,13 @@
 
 namespace Kernel {
 
-FileDescriptorManager::FileDescriptorManager(int32_t size) : size(size), descriptorTable(new Filesystem::Node*[size]) {
+FileDescriptorManager::FileDescriptorManager(int32_t size) : size(size), descriptorTable(new FileDescriptor[size]) {
     if (size < 0) {
         Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "FileDescriptorManager: Size is negative!");
     }
 
     for (int32_t i = 0; i < size; i++) {
-        descriptorTable[i] = nullptr;
+        descriptorTable[i] = {nullptr, Util::Io::File::REGULAR};
     }
 }
 
@@ -24,8 +24,8 @@ FileDescriptorManager::~FileDescriptorManager() {
 
 int32_t FileDescriptorManager::registerFile(Filesystem::Node *node) {
     for (int32_t fileDescriptor = 0; fileDescriptor < size; fileDescriptor++) {
-        if (descriptorTable[fileDescriptor] == nullptr) {
-            descriptorTable[fileDescriptor] = node;
+        if (descriptorTable[fileDescriptor].node == nullptr) {
+            descriptorTable[fileDescriptor] = {node, node->getType()};
             return fileDescriptor;
         }
     }
@@ -48,24 +48,48 @@ void FileDescriptorManager::closeFile(int32_t fileDescriptor) {
         Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Invalid file descriptor!");
     }
 
-    auto *node = descriptorTable[fileDescriptor];
+    auto *node = descriptorTable[fileDescriptor].node;
     if (node != nullptr) {
         delete node;
-        descriptorTable[fileDescriptor] = nullptr;
+        descriptorTable[fileDescriptor].node = nullptr;
     }
 }
 
 Filesystem::Node &FileDescriptorManager::getNode(int32_t fileDescriptor) {
-    if (fileDescriptor == -1) {
+    return *getDescriptor(fileDescriptor).node;
+}
+
+Util::Io::File::Type FileDescriptorManager::getType(int32_t fileDescriptor) const {
+    return getDescriptor(fileDescriptor).type;
+}
+
+uint64_t FileDescriptorManager::readFile(int32_t fileDescriptor, uint8_t *targetBuffer, uint64_t pos, uint64_t length) {
+    const auto &descriptor = getDescriptor(fileDescriptor);
+    if (descriptor.type == Util::Io::File::REGULAR) {
+        auto fileLength = descriptor.node->getLength();
+        if (pos >= fileLength) {
+            return 0;
+        }
+
+        if (length > fileLength - pos) {
+            length = fileLength - pos;
+        }
+    }
+
+    return descriptor.node->readData(targetBuffer, pos, length);
+}
+
+const FileDescriptorManager::FileDescriptor& FileDescriptorManager::getDescriptor(int32_t fileDescriptor) const {
+    if (fileDescriptor < 0 || fileDescriptor >= size) {
         Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Invalid file descriptor!");
     }
 
-    auto *node = descriptorTable[fileDescriptor];
-    if (node == nullptr) {
+    const auto &descriptor = descriptorTable[fileDescriptor];
+    if (descriptor.node == nullptr) {
         Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Invalid file descriptor!");
     }
 
-    return *node;
+    return descriptor;
 }
 
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <cstdint>
 
 #include "lib/util/base/String.h"
+#include "lib/util/io/file/File.h"
 
 namespace Filesystem {
 class Node;
@@ -42,10 +43,30 @@ public:
 
     Filesystem::Node& getNode(int32_t fileDescriptor);
 
+    /**
+     * Get the type of an open file. The type is queried once, when the file is registered.
+     */
+    [[nodiscard]] Util::Io::File::Type getType(int32_t fileDescriptor) const;
+
+    /**
+     * Read from an open file. Reads from regular files are limited to the file's length,
+     * so that reading at or behind the end returns 0 without calling into the driver.
+     *
+     * @return The number of bytes read (0 at the end of a regular file)
+     */
+    uint64_t readFile(int32_t fileDescriptor, uint8_t *targetBuffer, uint64_t pos, uint64_t length);
+
 private:
 
+    struct FileDescriptor {
+        Filesystem::Node *node;
+        Util::Io::File::Type type;
+    };
+
+    [[nodiscard]] const FileDescriptor& getDescriptor(int32_t fileDescriptor) const;
+
     int32_t size;
-    Filesystem::Node **descriptorTable;
+    FileDescriptor *descriptorTable;
 
     static const constexpr int32_t DEFAULT_TABLE_SIZE = 1024;
 
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "InterruptAffinityNode.h"
+
+#include "kernel/system/System.h"
+#include "kernel/service/InterruptService.h"
+#include "device/interrupt/InterruptRequest.h"
+#include "lib/util/collection/Array.h"
+
+namespace Kernel {
+
+InterruptAffinityNode::InterruptAffinityNode(const Util::String &name) : StringNode(name) {}
+
+Util::String InterruptAffinityNode::getString() {
+    auto &interruptService = System::getService<InterruptService>();
+    Util::String result;
+
+    for (uint32_t i = Device::InterruptRequest::PIT; i <= Device::InterruptRequest::AHCI; i++) {
+        if (isConfigurable(i)) {
+            result += Util::String::format("%u: %x\n", i, interruptService.getHardwareInterruptAffinity(static_cast<Device::InterruptRequest>(i)));
+        }
+    }
+
+    return result;
+}
+
+uint64_t InterruptAffinityNode::writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) {
+    const auto arguments = Util::String(sourceBuffer, numBytes).strip().split(" ");
+    if (arguments.length() != 2) {
+        return 0;
+    }
+
+    const auto interrupt = static_cast<uint32_t>(Util::String::parseInt(arguments[0]));
+    const auto cpuMask = static_cast<uint32_t>(Util::String::parseHexInt(arguments[1]));
+    if (interrupt > Device::InterruptRequest::AHCI || !isConfigurable(interrupt)) {
+        return 0;
+    }
+
+    return System::getService<InterruptService>().setHardwareInterruptAffinity(static_cast<Device::InterruptRequest>(interrupt), cpuMask) ? numBytes : 0;
+}
+
+bool InterruptAffinityNode::isConfigurable(uint32_t interrupt) {
+    if (interrupt == Device::InterruptRequest::CASCADE) {
+        return false;
+    }
+
+    return interrupt <= Device::InterruptRequest::SECONDARY_ATA || System::getService<InterruptService>().usesApic();
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_INTERRUPTAFFINITYNODE_H
+#define HHUOS_INTERRUPTAFFINITYNODE_H
+
+#include <cstdint>
+
+#include "filesystem/memory/StringNode.h"
+#include "lib/util/base/String.h"
+
+namespace Kernel {
+
+/**
+ * Shows the CPU affinity of each hardware interrupt as a hexadecimal bitmask (one bit per CPU id).
+ * The affinity of an interrupt can be changed by writing "<irq> <mask>" (e.g. "11 3"), with the mask given in hexadecimal.
+ */
+class InterruptAffinityNode : public Filesystem::Memory::StringNode {
+
+public:
+    /**
+     * Constructor.
+     */
+    explicit InterruptAffinityNode(const Util::String &name);
+
+    /**
+     * Copy Constructor.
+     */
+    InterruptAffinityNode(const InterruptAffinityNode &copy) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    InterruptAffinityNode& operator=(const InterruptAffinityNode &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~InterruptAffinityNode() override = default;
+
+    /**
+     * Overriding function from StringNode.
+     */
+    Util::String getString() override;
+
+    /**
+     * Overriding function from MemoryNode.
+     */
+    uint64_t writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) override;
+
+private:
+
+    static bool isConfigurable(uint32_t interrupt);
+};
+
+}
+
+#endif
@@ -18,20 +18,25 @@
 #include "kernel/service/InterruptService.h"
 #include "kernel/system/System.h"
 #include "device/cpu/Cpu.h"
-#include "lib/util/collection/ArrayList.h"
 #include "kernel/service/ProcessService.h"
 #include "kernel/interrupt/InterruptDispatcher.h"
 #include "kernel/interrupt/InterruptHandler.h"
 #include "kernel/process/Process.h"
 #include "kernel/process/ThreadState.h"
 #include "lib/util/base/Exception.h"
-#include "lib/util/collection/List.h"
 #include "lib/util/io/stream/PrintStream.h"
 #include "lib/util/base/System.h"
 #include "kernel/interrupt/InterruptVector.h"
+#include "lib/util/async/Atomic.h"
+#include "lib/util/base/Address.h"
+#include "lib/util/hardware/CpuId.h"
+#include "kernel/system/Processor.h"
 
 namespace Kernel {
 
+InterruptDispatcher::InterruptDispatcher() :
+        timestampCounterAvailable(Util::Hardware::CpuId::isAvailable() && (Util::Hardware::CpuId::getCpuFeatureBits() & Util::Hardware::CpuId::TSC) != 0) {}
+
 void InterruptDispatcher::dispatch(const InterruptFrame &frame) {
     auto &interruptService = System::getService<InterruptService>();
     auto slot = static_cast<InterruptVector>(frame.interrupt);
@@ -49,33 +54,94 @@ void InterruptDispatcher::dispatch(const InterruptFrame &frame) {
 
     // Ignore spurious interrupts
     if (interruptService.checkSpuriousInterrupt(slot)) {
+        counters.get().spuriousCount[slot]++;
         return;
     }
 
     // Throw exception, if there is no handler registered
-    auto *handlerList = handler[slot];
-    if (handlerList == nullptr) {
+    const auto *handlerArray = handler[slot];
+    if (handlerArray == nullptr) {
         Util::Exception::throwException(Util::Exception::ILLEGAL_STATE, "No handler registered!");
     }
 
+    counters.get().count[slot]++;
+    uint64_t startCycles = timestampCounterAvailable ? Device::Cpu::readTimestampCounter() : 0;
+
     // Call installed interrupt handlers
-    for (uint32_t i = 0; i < handlerList->size(); i++) {
-        handlerList->get(i)->trigger(frame);
+    for (uint32_t i = 0; i < handlerArray->count; i++) {
+        handlerArray->handlers[i]->trigger(frame);
+    }
+
+    if (timestampCounterAvailable) {
+        recordDuration(slot, Device::Cpu::readTimestampCounter() - startCycles);
     }
 
     interruptService.sendEndOfInterrupt(slot);
 }
 
 void InterruptDispatcher::assign(uint8_t slot, InterruptHandler &isr) {
-    if (handler[slot] == nullptr) {
-        handler[slot] = new Util::ArrayList<InterruptHandler*>;
+    assignLock.acquire();
+
+    const auto *oldArray = handler[slot];
+    auto *newArray = new HandlerArray{};
+    if (oldArray != nullptr) {
+        if (oldArray->count == MAX_HANDLERS_PER_VECTOR) {
+            assignLock.release();
+            Util::Exception::throwException(Util::Exception::OUT_OF_BOUNDS, "InterruptDispatcher: Too many handlers registered to a single vector!");
+        }
+
+        *newArray = *oldArray;
     }
 
-    handler[slot]->add(&isr);
+    newArray->handlers[newArray->count++] = &isr;
+
+    // Publish the new array with a single atomic store.
+    // The old array is not freed, since another core may still be iterating over it.
+    // Handlers are registered only a few times per boot, so this leaks at most a few hundred bytes.
+    Util::Async::Atomic<uint32_t>(reinterpret_cast<uint32_t&>(handler[slot])).set(reinterpret_cast<uint32_t>(newArray));
+
+    assignLock.release();
 }
 
 bool InterruptDispatcher::isUnrecoverableException(InterruptVector slot) {
     return (slot < PIT || (slot >= NULL_POINTER && slot <= UNSUPPORTED_OPERATION)) && handler[slot] == nullptr;
 }
 
+InterruptDispatcher::Statistics InterruptDispatcher::getStatistics(uint8_t slot) const {
+    auto ret = statistics[slot];
+    for (uint32_t i = 0; i < Processor::getCount(); i++) {
+        const auto &processorCounters = counters.get(i);
+        ret.count += processorCounters.count[slot];
+        ret.spuriousCount += processorCounters.spuriousCount[slot];
+    }
+
+    return ret;
+}
+
+bool InterruptDispatcher::isMeasuringDurations() const {
+    return timestampCounterAvailable;
+}
+
+void InterruptDispatcher::resetStatistics() {
+    Util::Address<uint32_t>(statistics).setRange(0, sizeof(statistics));
+    for (uint32_t i = 0; i < Processor::getCount(); i++) {
+        Util::Address<uint32_t>(&counters.get(i)).setRange(0, sizeof(Counters));
+    }
+}
+
+void InterruptDispatcher::recordDuration(uint8_t slot, uint64_t cycles) {
+    auto &slotStatistics = statistics[slot];
+    slotStatistics.totalCycles += cycles;
+    if (cycles > slotStatistics.maxCycles) {
+        slotStatistics.maxCycles = cycles;
+    }
+
+    uint32_t bucket = 0;
+    for (auto value = cycles >> (HISTOGRAM_FIRST_BUCKET_SHIFT + 1); value > 0 && bucket < HISTOGRAM_BUCKETS - 1; value >>= 1) {
+        bucket++;
+    }
+
+    Util::Async::Atomic<uint32_t>(slotStatistics.histogram[bucket]).inc();
+}
+
 }
\ No newline at end of file
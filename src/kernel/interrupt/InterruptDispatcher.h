@@ -20,11 +20,8 @@
 
 #include <cstdint>
 
-namespace Util {
-
-template <typename T> class List;
-
-}  // namespace Util
+#include "lib/util/async/Spinlock.h"
+#include "kernel/system/PerCpu.h"
 
 namespace Kernel {
 class InterruptHandler;
@@ -42,10 +39,29 @@ class InterruptDispatcher {
 
 public:
 
+    static const constexpr uint32_t MAX_HANDLERS_PER_VECTOR = 16;
+    static const constexpr uint32_t HISTOGRAM_BUCKETS = 16;
+    static const constexpr uint32_t HISTOGRAM_FIRST_BUCKET_SHIFT = 8;
+
+    /**
+     * Statistics, collected per interrupt vector.
+     * Handler durations are measured in TSC cycles and sorted into a logarithmic histogram,
+     * where bucket i counts all durations below 2^(i + HISTOGRAM_FIRST_BUCKET_SHIFT + 1) cycles
+     * (the last bucket counts everything above). If a handler yields to another thread
+     * (e.g. the timer interrupt), the measured duration includes the runtime of that thread.
+     */
+    struct Statistics {
+        uint32_t count;
+        uint32_t spuriousCount;
+        uint64_t totalCycles;
+        uint64_t maxCycles;
+        uint32_t histogram[HISTOGRAM_BUCKETS];
+    };
+
     /**
      * Default Constructor.
      */
-    InterruptDispatcher() = default;
+    InterruptDispatcher();
 
     InterruptDispatcher(const InterruptDispatcher &other) = delete;
 
@@ -55,6 +71,8 @@ public:
 
     /**
      * Register an interrupt handler to an interrupt number.
+     * The handler array of the interrupt number is copied and the new array is published atomically,
+     * so that dispatch() never needs to take a lock.
      *
      * @param slot Interrupt number for this handler
      * @param isr Pointer to the handler itself
@@ -68,11 +86,54 @@ public:
      */
     void dispatch(const InterruptFrame &frame);
 
+    /**
+     * Get the collected statistics for an interrupt vector.
+     *
+     * @param slot The interrupt number
+     * @return A copy of the statistics
+     */
+    [[nodiscard]] Statistics getStatistics(uint8_t slot) const;
+
+    /**
+     * Check, whether handler durations are measured (requires a time stamp counter).
+     */
+    [[nodiscard]] bool isMeasuringDurations() const;
+
+    /**
+     * Reset the statistics of all interrupt vectors.
+     */
+    void resetStatistics();
+
 private:
 
+    /**
+     * Immutable set of handlers for a single interrupt vector.
+     * Once published, an array is never modified, so it can be read without locking.
+     */
+    struct HandlerArray {
+        uint32_t count;
+        InterruptHandler *handlers[MAX_HANDLERS_PER_VECTOR];
+    };
+
     bool isUnrecoverableException(Kernel::InterruptVector slot);
 
-    Util::List<InterruptHandler*>* handler[256];
+    void recordDuration(uint8_t slot, uint64_t cycles);
+
+    /**
+     * Interrupt counters of a single core. These are incremented on every interrupt,
+     * so each core counts in its own instance and getStatistics() sums them up.
+     */
+    struct Counters {
+        uint32_t count[256];
+        uint32_t spuriousCount[256];
+    };
+
+    HandlerArray *handler[256]{};
+    Util::Async::Spinlock assignLock;
+    Statistics statistics[256]{};
+    PerCpu<Counters> counters;
+
+    bool timestampCounterAvailable;
 
 };
 
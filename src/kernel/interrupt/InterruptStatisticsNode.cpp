@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "InterruptStatisticsNode.h"
+
+#include "kernel/system/System.h"
+#include "kernel/service/InterruptService.h"
+#include "kernel/interrupt/InterruptDispatcher.h"
+#include "kernel/interrupt/InterruptVector.h"
+
+namespace Kernel {
+
+InterruptStatisticsNode::InterruptStatisticsNode(const Util::String &name) : StringNode(name) {}
+
+Util::String InterruptStatisticsNode::getString() {
+    auto &interruptService = System::getService<InterruptService>();
+    bool measuring = interruptService.isMeasuringInterruptDurations();
+    Util::String result;
+
+    for (uint32_t i = 0; i < 256; i++) {
+        const auto statistics = interruptService.getInterruptStatistics(static_cast<InterruptVector>(i));
+        if (statistics.count == 0 && statistics.spuriousCount == 0) {
+            continue;
+        }
+
+        result += Util::String::format("Vector %u: Count [%u], Spurious [%u]", i, statistics.count, statistics.spuriousCount);
+        if (measuring) {
+            result += Util::String::format(", Average cycles [%u], Max cycles [%u]\n  Histogram (<2^n cycles, n = %u..%u):",
+                                           divide(statistics.totalCycles, statistics.count), truncate(statistics.maxCycles),
+                                           InterruptDispatcher::HISTOGRAM_FIRST_BUCKET_SHIFT + 1,
+                                           InterruptDispatcher::HISTOGRAM_FIRST_BUCKET_SHIFT + InterruptDispatcher::HISTOGRAM_BUCKETS);
+            for (uint32_t j = 0; j < InterruptDispatcher::HISTOGRAM_BUCKETS; j++) {
+                result += Util::String::format(" %u", statistics.histogram[j]);
+            }
+        }
+
+        result += "\n";
+    }
+
+    return result;
+}
+
+uint64_t InterruptStatisticsNode::writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) {
+    System::getService<InterruptService>().resetInterruptStatistics();
+    return numBytes;
+}
+
+uint32_t InterruptStatisticsNode::divide(uint64_t dividend, uint32_t divisor) {
+    // There is no 64-bit division available in the kernel -> Scale down both values, until the dividend fits into 32 bits
+    while (dividend > UINT32_MAX) {
+        dividend >>= 1;
+        divisor >>= 1;
+    }
+
+    return divisor == 0 ? 0 : static_cast<uint32_t>(dividend) / divisor;
+}
+
+uint32_t InterruptStatisticsNode::truncate(uint64_t value) {
+    return value > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(value);
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_INTERRUPTSTATISTICSNODE_H
+#define HHUOS_INTERRUPTSTATISTICSNODE_H
+
+#include <cstdint>
+
+#include "filesystem/memory/StringNode.h"
+#include "lib/util/base/String.h"
+
+namespace Kernel {
+
+/**
+ * Shows the interrupt statistics collected by the InterruptDispatcher.
+ * Only vectors, which have been triggered at least once are listed.
+ * Writing anything to this node resets all statistics.
+ */
+class InterruptStatisticsNode : public Filesystem::Memory::StringNode {
+
+public:
+    /**
+     * Constructor.
+     */
+    explicit InterruptStatisticsNode(const Util::String &name);
+
+    /**
+     * Copy Constructor.
+     */
+    InterruptStatisticsNode(const InterruptStatisticsNode &copy) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    InterruptStatisticsNode& operator=(const InterruptStatisticsNode &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~InterruptStatisticsNode() override = default;
+
+    /**
+     * Overriding function from StringNode.
+     */
+    Util::String getString() override;
+
+    /**
+     * Overriding function from MemoryNode.
+     */
+    uint64_t writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) override;
+
+private:
+
+    static uint32_t divide(uint64_t dividend, uint32_t divisor);
+
+    static uint32_t truncate(uint64_t value);
+};
+
+}
+
+#endif
@@ -66,6 +66,10 @@ enum InterruptVector : uint8_t {
     AHCI = 48,
     // Possibly some other interrupts supported by IO APICs
 
+    // Message signaled interrupts (96 - 127), allocated dynamically by the InterruptService
+    MESSAGE_SIGNALED_START = 0x60,
+    MESSAGE_SIGNALED_END = 0x7f,
+
     SYSTEM_CALL = 0x86,
 
     // Software exceptions
@@ -151,9 +151,12 @@ wrapper_body:
     mov ax, 0x10
     mov ds, ax
     mov es, ax
-    mov fs, ax
     mov gs, ax
 
+    ; FS points to the per-core data segment in kernel mode (see Processor.h)
+    mov ax, 0x30
+    mov fs, ax
+
     ; Restore eax
     pop eax
 
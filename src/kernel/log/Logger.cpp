@@ -36,7 +36,7 @@
 namespace Kernel {
 
 Logger::LogLevel Logger::currentLevel = LogLevel::TRACE;
-Util::Async::Spinlock Logger::lock;
+Util::Async::Spinlock Logger::lock("Logger");
 Util::HashMap<Util::Io::OutputStream*, Util::Io::PrintStream*> Logger::streamMap;
 Util::ArrayList<Util::String> Logger::buffer;
 
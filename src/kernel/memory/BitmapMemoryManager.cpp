@@ -28,7 +28,7 @@ BitmapMemoryManager::BitmapMemoryManager(uint8_t *startAddress, uint8_t *endAddr
 void *BitmapMemoryManager::allocateBlock() {
     uint32_t block = bitmap.findAndSet();
 
-    if (block == bitmap.getSize()) {
+    if (block == Util::Async::AtomicBitmap::INVALID_INDEX) {
         handleError();
         return nullptr;
     }
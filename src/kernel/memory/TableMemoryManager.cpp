@@ -24,7 +24,7 @@ namespace Kernel {
 Logger TableMemoryManager::log = Logger::get("TableMemoryManager");
 
 TableMemoryManager::TableMemoryManager(BitmapMemoryManager &bitmapMemoryManager, uint8_t *startAddress, uint8_t *endAddress, uint32_t blockSize) :
-        bitmapMemoryManager(bitmapMemoryManager), startAddress(startAddress), endAddress(endAddress), blockSize(blockSize) {
+        bitmapMemoryManager(bitmapMemoryManager), startAddress(startAddress), endAddress(endAddress), blockSize(blockSize), searchHint(startAddress) {
     uint32_t memorySize = endAddress - startAddress + 1;
     uint32_t blockCount = memorySize / blockSize;
     if (memorySize % blockCount != 0) {
@@ -59,6 +59,12 @@ TableMemoryManager::TableMemoryManager(BitmapMemoryManager &bitmapMemoryManager,
             entry.setInstalled(installed);
         }
     }
+
+    fullAllocationTables = new Util::Async::AtomicBitmap(referenceTableSizeInBlocks * referenceTableEntriesPerBlock);
+}
+
+TableMemoryManager::~TableMemoryManager() {
+    delete fullAllocationTables;
 }
 
 void TableMemoryManager::setMemory(uint8_t *start, uint8_t *end, uint16_t useCount, bool reserved) {
@@ -90,6 +96,10 @@ void TableMemoryManager::setMemory(uint8_t *start, uint8_t *end, uint16_t useCou
                 allocationTableEntry.setUseCount(useCount);
             }
 
+            if (useCount == 0 && !reserved) {
+                fullAllocationTables->unset(i * referenceTableEntriesPerBlock + j);
+            }
+
             referenceTableEntry.releaseLock();
         }
     }
@@ -112,7 +122,19 @@ uint32_t TableMemoryManager::calculateAddress(const TableMemoryManager::TableInd
 }
 
 void *TableMemoryManager::allocateBlock() {
-    return allocateBlockAfterAddress(reinterpret_cast<void*>(startAddress));
+    // Next fit: Continue searching at the last allocated block and wrap around, if no free block is found behind it
+    uint8_t *hint = searchHint;
+    void *block = findFreeBlock(hint, endAddress);
+    if (block == nullptr && hint > startAddress) {
+        block = findFreeBlock(startAddress, endAddress);
+    }
+
+    if (block == nullptr) {
+        Util::Exception::throwException(Util::Exception::ILLEGAL_STATE, "TableMemoryManager: Allocation failed!");
+    }
+
+    searchHint = static_cast<uint8_t*>(block);
+    return block;
 }
 
 void *TableMemoryManager::allocateBlockAtAddress(void *address) {
@@ -153,11 +175,62 @@ void TableMemoryManager::freeBlock(void *pointer) {
     auto &allocationTableEntry = allocationTable[index.allocationTableIndex];
 
     allocationTableEntry.decrementUseCount();
+
+    // The table is marked as not full after the block has been released, so that a concurrent search can not miss it
+    if (allocationTableEntry.getUseCount() == 0 && !allocationTableEntry.isReserved()) {
+        fullAllocationTables->unset(index.referenceTableArrayIndex * referenceTableEntriesPerBlock + index.referenceTableIndex);
+    }
+}
+
+void TableMemoryManager::freeBlocks(const uint32_t *addresses, uint32_t count) {
+    uint32_t currentTableIndex = 0xFFFFFFFF;
+    AllocationTableEntry *allocationTable = nullptr;
+    bool tableFreed = false;
+
+    for (uint32_t i = 0; i < count; i++) {
+        auto *pointer = reinterpret_cast<uint8_t*>(addresses[i]);
+        if (pointer > endAddress) {
+            continue;
+        }
+
+        const auto index = calculateIndex(pointer);
+        uint32_t tableIndex = index.referenceTableArrayIndex * referenceTableEntriesPerBlock + index.referenceTableIndex;
+        if (tableIndex != currentTableIndex) {
+            if (tableFreed) {
+                fullAllocationTables->unset(currentTableIndex);
+            }
+
+            auto *referenceTable = reinterpret_cast<ReferenceTableEntry*>(referenceTableArray[index.referenceTableArrayIndex]);
+            allocationTable = reinterpret_cast<AllocationTableEntry*>(referenceTable[index.referenceTableIndex].getAddress());
+            currentTableIndex = tableIndex;
+            tableFreed = false;
+        }
+
+        auto &allocationTableEntry = allocationTable[index.allocationTableIndex];
+        allocationTableEntry.decrementUseCount();
+        if (allocationTableEntry.getUseCount() == 0 && !allocationTableEntry.isReserved()) {
+            tableFreed = true;
+        }
+    }
+
+    // As in freeBlock(), tables are only marked as not full after their blocks have been released
+    if (tableFreed) {
+        fullAllocationTables->unset(currentTableIndex);
+    }
 }
 
 void *TableMemoryManager::allocateBlockAfterAddress(void *address) {
-    auto startIndex = calculateIndex(reinterpret_cast<uint8_t*>(address));
-    auto endIndex = calculateIndex(endAddress);
+    void *block = findFreeBlock(reinterpret_cast<uint8_t*>(address), endAddress);
+    if (block == nullptr) {
+        Util::Exception::throwException(Util::Exception::ILLEGAL_STATE, "TableMemoryManager: Allocation failed!");
+    }
+
+    return block;
+}
+
+void *TableMemoryManager::findFreeBlock(uint8_t *from, uint8_t *to) {
+    auto startIndex = calculateIndex(from);
+    auto endIndex = calculateIndex(to);
 
     for (uint32_t i = startIndex.referenceTableArrayIndex; i <= endIndex.referenceTableArrayIndex; i++) {
         auto *referenceTable = reinterpret_cast<ReferenceTableEntry*>(referenceTableArray[i]);
@@ -165,6 +238,11 @@ void *TableMemoryManager::allocateBlockAfterAddress(void *address) {
         uint32_t referenceTableEndIndex = (i == endIndex.referenceTableArrayIndex) ? endIndex.referenceTableIndex : referenceTableEntriesPerBlock - 1;
 
         for (uint32_t j = referenceTableStartIndex; j <= referenceTableEndIndex; j++) {
+            uint32_t tableIndex = i * referenceTableEntriesPerBlock + j;
+            if (fullAllocationTables->check(tableIndex, true)) {
+                continue;
+            }
+
             auto &referenceTableEntry = referenceTable[j];
             if (!referenceTableEntry.tryAcquireLock()) {
                 continue;
@@ -179,24 +257,37 @@ void *TableMemoryManager::allocateBlockAfterAddress(void *address) {
             auto *allocationTable = reinterpret_cast<AllocationTableEntry*>(referenceTableEntry.getAddress());
             uint32_t allocationTableStartIndex = (j == referenceTableStartIndex) ? startIndex.allocationTableIndex : 0;
             uint32_t allocationTableEndIndex = (j == referenceTableEndIndex) ? endIndex.allocationTableIndex : allocationTableEntriesPerBlock - 1;
-
-            for (uint32_t k = allocationTableStartIndex; k <= allocationTableEndIndex; k++) {
-                auto &allocationTableEntry = allocationTable[k];
-                if (allocationTableEntry.isReserved() || allocationTableEntry.getUseCount() > 0) {
-                    continue;
+            bool wholeTable = allocationTableStartIndex == 0 && allocationTableEndIndex == allocationTableEntriesPerBlock - 1;
+
+            // If the whole table has been searched without success, it is marked as full and searched a second time,
+            // since a block may have been freed concurrently, before the table has been marked
+            for (uint32_t pass = 0; pass < (wholeTable ? 2 : 1); pass++) {
+                for (uint32_t k = allocationTableStartIndex; k <= allocationTableEndIndex; k++) {
+                    auto &allocationTableEntry = allocationTable[k];
+                    if (allocationTableEntry.isReserved() || allocationTableEntry.getUseCount() > 0) {
+                        continue;
+                    }
+
+                    allocationTableEntry.incrementUseCount();
+                    if (pass > 0) {
+                        fullAllocationTables->unset(tableIndex);
+                    }
+
+                    referenceTableEntry.releaseLock();
+                    const TableIndex index = {i, j, k};
+                    return reinterpret_cast<void*>(calculateAddress(index));
                 }
 
-                allocationTableEntry.incrementUseCount();
-                referenceTableEntry.releaseLock();
-                const TableIndex index = {i, j, k};
-                return reinterpret_cast<void*>(calculateAddress(index));
+                if (wholeTable && pass == 0) {
+                    fullAllocationTables->set(tableIndex);
+                }
             }
 
             referenceTableEntry.releaseLock();
         }
     }
 
-    Util::Exception::throwException(Util::Exception::ILLEGAL_STATE, "TableMemoryManager: Allocation failed!");
+    return nullptr;
 }
 
 uint32_t TableMemoryManager::getTotalMemory() const {
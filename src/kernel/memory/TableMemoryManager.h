@@ -21,6 +21,7 @@
 #include <cstdint>
 
 #include "lib/util/async/Atomic.h"
+#include "lib/util/async/AtomicBitmap.h"
 #include "kernel/memory/BlockMemoryManager.h"
 #include "lib/util/base/Exception.h"
 
@@ -49,7 +50,7 @@ public:
     /**
      * Destructor.
      */
-    ~TableMemoryManager() override = default;
+    ~TableMemoryManager() override;
 
     void setMemory(uint8_t *start, uint8_t *end, uint16_t useCount, bool reserved);
 
@@ -61,6 +62,15 @@ public:
 
     void freeBlock(void *pointer) override;
 
+    /**
+     * Free multiple blocks at once. The allocation table of each block is only looked up and marked as not full
+     * once for every run of consecutive blocks, that belong to the same table.
+     *
+     * @param addresses Addresses of the blocks
+     * @param count Amount of blocks
+     */
+    void freeBlocks(const uint32_t *addresses, uint32_t count);
+
     [[nodiscard]] uint32_t getTotalMemory() const override;
 
     [[nodiscard]] uint32_t getBlockSize() const override;
@@ -77,6 +87,13 @@ private:
 
     void printAllocationTable(uint32_t referenceTableArrayIndex, uint32_t referenceTableIndex);
 
+    /**
+     * Search for an unused block in the given range and allocate it.
+     *
+     * @return The allocated block, or nullptr if no block is available in the given range
+     */
+    [[nodiscard]] void* findFreeBlock(uint8_t *from, uint8_t *to);
+
     struct ReferenceTableEntry {
 
     private:
@@ -223,6 +240,17 @@ private:
 
     ReferenceTableEntry **referenceTableArray;
 
+    /**
+     * One bit per allocation table, that is set, when the table has no unused entries left.
+     * Full tables are skipped, when searching for a free block.
+     */
+    Util::Async::AtomicBitmap *fullAllocationTables;
+
+    /**
+     * Next fit hint: Address of the last block, that has been allocated via allocateBlock().
+     */
+    uint8_t *searchHint;
+
     static Logger log;
     static const constexpr uint32_t MIN_BITMAP_BLOCK_SIZE = 16;
 };
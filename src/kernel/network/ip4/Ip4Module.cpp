@@ -44,11 +44,19 @@
 #include "lib/util/network/ip4/Ip4Route.h"
 #include "lib/util/network/ip4/Ip4SubnetAddress.h"
 #include "lib/util/collection/Iterator.h"
+#include "lib/util/collection/ArrayList.h"
+#include "kernel/process/ReadCopyUpdate.h"
 
 namespace Kernel::Network::Ip4 {
 
 Kernel::Logger Ip4Module::log = Kernel::Logger::get("IPv4");
 
+Ip4Module::Ip4Module() : interfaces(new Util::Array<Ip4Interface>(0)) {}
+
+Ip4Module::~Ip4Module() {
+    delete interfaces;
+}
+
 void Ip4Module::readPacket(Util::Io::ByteArrayInputStream &stream, LayerInformation information, Device::Network::NetworkDevice &device) {
     auto &tmpStream = reinterpret_cast<Util::Io::ByteArrayInputStream&>(stream);
     auto *buffer = tmpStream.getBuffer() + tmpStream.getPosition();
@@ -127,13 +135,13 @@ Ip4Interface Ip4Module::writeHeader(Util::Io::ByteArrayOutputStream &stream, con
 Util::Array<Ip4Interface> Ip4Module::getInterfaces(const Util::String &deviceIdentifier) {
     auto ret = Util::ArrayList<Ip4Interface>();
 
-    lock.acquire();
-    for (auto interface : interfaces) {
+    auto token = ReadCopyUpdate::readLock();
+    for (const auto &interface : *ReadCopyUpdate::read(interfaces)) {
         if (interface.getDeviceIdentifier() == deviceIdentifier) {
             ret.add(interface);
         }
     }
-    lock.release();
+    ReadCopyUpdate::readUnlock(token);
 
     return ret.toArray();
 }
@@ -141,45 +149,68 @@ Util::Array<Ip4Interface> Ip4Module::getInterfaces(const Util::String &deviceIde
 Util::Array<Ip4Interface> Ip4Module::getTargetInterfaces(const Util::Network::Ip4::Ip4Address &address) {
     auto ret = Util::ArrayList<Ip4Interface>();
 
-    lock.acquire();
-    for (const auto &interface : interfaces) {
+    auto token = ReadCopyUpdate::readLock();
+    for (const auto &interface : *ReadCopyUpdate::read(interfaces)) {
         if (interface.isTargetOf(address)) {
             ret.add(interface);
         }
     }
-    lock.release();
+    ReadCopyUpdate::readUnlock(token);
 
     return ret.toArray();
 }
 
 bool Ip4Module::registerInterface(const Util::Network::Ip4::Ip4SubnetAddress &address, Device::Network::NetworkDevice &device) {
-    lock.acquire();
     auto interface = Ip4Interface(address, device);
-    if (interfaces.contains(interface) || interface.getIp4Address() == Util::Network::Ip4::Ip4Address::ANY) {
-        lock.release();
+    if (interface.getIp4Address() == Util::Network::Ip4::Ip4Address::ANY) {
         return false;
     }
 
-    auto ret = interfaces.add(interface);
-    lock.release();
+    lock.acquire();
+    auto *oldInterfaces = interfaces;
+    for (auto &existingInterface : *oldInterfaces) {
+        if (existingInterface == interface) {
+            lock.release();
+            return false;
+        }
+    }
 
-    if (ret) {
-        auto &arpModule = Kernel::System::getService<Kernel::NetworkService>().getNetworkStack().getArpModule();
-        arpModule.setEntry(address.getIp4Address(), device.getMacAddress());
+    auto *newInterfaces = new Util::Array<Ip4Interface>(oldInterfaces->length() + 1);
+    for (uint32_t i = 0; i < oldInterfaces->length(); i++) {
+        (*newInterfaces)[i] = (*oldInterfaces)[i];
     }
+    (*newInterfaces)[oldInterfaces->length()] = interface;
 
-    return ret;
+    ReadCopyUpdate::publish(interfaces, newInterfaces);
+    ReadCopyUpdate::retire(oldInterfaces);
+    lock.release();
+
+    auto &arpModule = Kernel::System::getService<Kernel::NetworkService>().getNetworkStack().getArpModule();
+    arpModule.setEntry(address.getIp4Address(), device.getMacAddress());
+
+    return true;
 }
 
 bool Ip4Module::removeInterface(const Util::Network::Ip4::Ip4SubnetAddress &address, const Util::String &deviceIdentifier) {
     lock.acquire();
-    for (const auto &interface : interfaces) {
+    auto *oldInterfaces = interfaces;
+    for (uint32_t i = 0; i < oldInterfaces->length(); i++) {
+        const auto &interface = (*oldInterfaces)[i];
         if (interface.getSubnetAddress() == address && interface.getDeviceIdentifier() == deviceIdentifier) {
             auto &arpModule = Kernel::System::getService<Kernel::NetworkService>().getNetworkStack().getArpModule();
             arpModule.removeEntry(interface.getIp4Address());
 
             routingModule.removeRoute(address, deviceIdentifier);
-            interfaces.remove(interface);
+
+            auto *newInterfaces = new Util::Array<Ip4Interface>(oldInterfaces->length() - 1);
+            for (uint32_t j = 0, k = 0; j < oldInterfaces->length(); j++) {
+                if (j != i) {
+                    (*newInterfaces)[k++] = (*oldInterfaces)[j];
+                }
+            }
+
+            ReadCopyUpdate::publish(interfaces, newInterfaces);
+            ReadCopyUpdate::retire(oldInterfaces);
 
             lock.release();
             return true;
@@ -27,7 +27,6 @@
 #include "lib/util/network/ip4/Ip4Header.h"
 #include "Ip4RoutingModule.h"
 #include "lib/util/collection/Array.h"
-#include "lib/util/collection/ArrayList.h"
 #include "lib/util/base/String.h"
 #include "kernel/network/ip4/Ip4Interface.h"
 #include "lib/util/async/ReentrantSpinlock.h"
@@ -62,7 +61,7 @@ public:
     /**
      * Default Constructor.
      */
-    Ip4Module() = default;
+    Ip4Module();
 
     /**
      * Copy Constructor.
@@ -77,7 +76,7 @@ public:
     /**
      * Destructor.
      */
-    ~Ip4Module() = default;
+    ~Ip4Module();
 
     Util::Array<Ip4Interface> getInterfaces(const Util::String &deviceIdentifier);
 
@@ -98,7 +97,8 @@ public:
 private:
 
     Ip4RoutingModule routingModule;
-    Util::ArrayList<Ip4Interface> interfaces;
+    // Published via read-copy-update, so that the packet path can look up interfaces without locking
+    Util::Array<Ip4Interface> *volatile interfaces;
     Util::Async::ReentrantSpinlock lock;
 
     static Kernel::Logger log;
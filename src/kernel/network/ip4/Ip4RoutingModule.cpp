@@ -31,43 +31,60 @@
 #include "lib/util/network/ip4/Ip4SubnetAddress.h"
 #include "kernel/network/ip4/Ip4Interface.h"
 #include "lib/util/collection/Iterator.h"
+#include "lib/util/collection/ArrayList.h"
+#include "kernel/process/ReadCopyUpdate.h"
 
 namespace Kernel::Network::Ip4 {
 
+Ip4RoutingModule::Ip4RoutingModule() : table(new RoutingTable{Util::Array<Util::Network::Ip4::Ip4Route>(0), Util::Network::Ip4::Ip4Route()}) {}
+
+Ip4RoutingModule::~Ip4RoutingModule() {
+    delete table;
+}
+
 bool Ip4RoutingModule::addRoute(const Util::Network::Ip4::Ip4Route &route) {
     auto &ip4Module = System::getService<NetworkService>().getNetworkStack().getIp4Module();
     if (ip4Module.getTargetInterfaces(route.getSourceAddress()).length() == 0) {
         return false;
     }
 
-    bool ret = false;
     lock.acquire();
 
+    bool contained = false;
+    for (const auto &currentRoute : table->routes) {
+        if (currentRoute == route) {
+            contained = true;
+            break;
+        }
+    }
+
     if (route.getAddress().getBitCount() == 0) {
-        routes.remove(route);
-        defaultRoute = route;
-        ret = true;
-    } else if (!routes.contains(route)) {
-        ret = routes.add(route);
+        updateRoutingTable(nullptr, contained ? &route : nullptr, route);
+        return lock.releaseAndReturn(true);
+    } else if (!contained) {
+        updateRoutingTable(&route, nullptr, table->defaultRoute);
+        return lock.releaseAndReturn(true);
     }
 
-    lock.release();
-    return ret;
+    return lock.releaseAndReturn(false);
 }
 
 bool Ip4RoutingModule::removeRoute(const Util::Network::Ip4::Ip4Route &route) {
-    bool ret;
     lock.acquire();
 
-    if (route == defaultRoute) {
-        defaultRoute = Util::Network::Ip4::Ip4Route();
-        ret = true;
-    } else {
-        ret = routes.remove(route);
+    if (route == table->defaultRoute) {
+        updateRoutingTable(nullptr, nullptr, Util::Network::Ip4::Ip4Route());
+        return lock.releaseAndReturn(true);
     }
 
-    lock.release();
-    return ret;
+    for (const auto &currentRoute : table->routes) {
+        if (currentRoute == route) {
+            updateRoutingTable(nullptr, &route, table->defaultRoute);
+            return lock.releaseAndReturn(true);
+        }
+    }
+
+    return lock.releaseAndReturn(false);
 }
 
 void Ip4RoutingModule::removeRoute(const Util::Network::Ip4::Ip4SubnetAddress &localAddress, const Util::String &device) {
@@ -75,59 +92,91 @@ void Ip4RoutingModule::removeRoute(const Util::Network::Ip4::Ip4SubnetAddress &l
     removeRoute(route);
 }
 
-const Util::Network::Ip4::Ip4Route &Ip4RoutingModule::getDefaultRoute() const {
-    return defaultRoute;
+Util::Network::Ip4::Ip4Route Ip4RoutingModule::getDefaultRoute() const {
+    auto token = ReadCopyUpdate::readLock();
+    auto ret = ReadCopyUpdate::read(table)->defaultRoute;
+    ReadCopyUpdate::readUnlock(token);
+
+    return ret;
 }
 
 Util::Array<Util::Network::Ip4::Ip4Route> Ip4RoutingModule::getRoutes(const Util::Network::Ip4::Ip4Address &sourceAddress) {
     auto ret = Util::ArrayList<Util::Network::Ip4::Ip4Route>();
     bool anySource = sourceAddress == Util::Network::Ip4::Ip4Address::ANY;
 
-    lock.acquire();
+    auto token = ReadCopyUpdate::readLock();
+    auto *currentTable = ReadCopyUpdate::read(table);
 
-    for (const auto &route : routes) {
+    for (const auto &route : currentTable->routes) {
         if (anySource || route.getSourceAddress() == sourceAddress) {
             ret.add(route);
         }
     }
 
-    if (anySource || defaultRoute.getSourceAddress() == sourceAddress) {
-        ret.add(defaultRoute);
+    if (anySource || currentTable->defaultRoute.getSourceAddress() == sourceAddress) {
+        ret.add(currentTable->defaultRoute);
     }
-    lock.release();
 
+    ReadCopyUpdate::readUnlock(token);
     return ret.toArray();
 }
 
-const Util::Network::Ip4::Ip4Route& Ip4RoutingModule::findRoute(const Util::Network::Ip4::Ip4Address &sourceAddress, const Util::Network::Ip4::Ip4Address &address) {
+Util::Network::Ip4::Ip4Route Ip4RoutingModule::findRoute(const Util::Network::Ip4::Ip4Address &sourceAddress, const Util::Network::Ip4::Ip4Address &address) {
     uint8_t longestPrefix = 0;
     const Util::Network::Ip4::Ip4Route *bestRoute = nullptr;
     bool anySource = sourceAddress == Util::Network::Ip4::Ip4Address::ANY;
 
-    lock.acquire();
-    for (const auto &route : routes) {
-        auto routeAddress = route.getSourceAddress();
+    auto token = ReadCopyUpdate::readLock();
+    auto *currentTable = ReadCopyUpdate::read(table);
 
+    for (const auto &route : currentTable->routes) {
         if (anySource || sourceAddress == route.getSourceAddress()) {
             auto subnetAddress = route.getTargetAddress();
             auto prefix = address.compareTo(subnetAddress);
 
             if (prefix >= subnetAddress.getBitCount() && prefix > longestPrefix) {
+                longestPrefix = prefix;
                 bestRoute = &route;
             }
         }
     }
-    lock.release();
 
     if (bestRoute == nullptr) {
+        const auto &defaultRoute = currentTable->defaultRoute;
         if (defaultRoute.isValid() && (anySource || sourceAddress == defaultRoute.getSourceAddress())) {
-            return defaultRoute;
+            auto ret = defaultRoute;
+            ReadCopyUpdate::readUnlock(token);
+            return ret;
         }
 
+        ReadCopyUpdate::readUnlock(token);
         Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Ip4RoutingModule: No route to host!");
     }
 
-    return *bestRoute;
+    auto ret = *bestRoute;
+    ReadCopyUpdate::readUnlock(token);
+    return ret;
+}
+
+void Ip4RoutingModule::updateRoutingTable(const Util::Network::Ip4::Ip4Route *addedRoute, const Util::Network::Ip4::Ip4Route *removedRoute, const Util::Network::Ip4::Ip4Route &defaultRoute) {
+    auto *oldTable = table;
+    const auto &oldRoutes = oldTable->routes;
+    auto newLength = oldRoutes.length() + (addedRoute == nullptr ? 0 : 1) - (removedRoute == nullptr ? 0 : 1);
+    auto *newTable = new RoutingTable{Util::Array<Util::Network::Ip4::Ip4Route>(newLength), defaultRoute};
+
+    uint32_t j = 0;
+    for (const auto &route : oldRoutes) {
+        if (removedRoute == nullptr || route != *removedRoute) {
+            newTable->routes[j++] = route;
+        }
+    }
+
+    if (addedRoute != nullptr) {
+        newTable->routes[j] = *addedRoute;
+    }
+
+    ReadCopyUpdate::publish(table, newTable);
+    ReadCopyUpdate::retire(oldTable);
 }
 
 }
\ No newline at end of file
@@ -21,7 +21,6 @@
 #ifndef HHUOS_IP4ROUTINGMODULE_H
 #define HHUOS_IP4ROUTINGMODULE_H
 
-#include "lib/util/collection/ArrayList.h"
 #include "lib/util/collection/Array.h"
 #include "lib/util/async/ReentrantSpinlock.h"
 #include "lib/util/base/String.h"
@@ -44,7 +43,7 @@ public:
     /**
      * Default Constructor.
      */
-    Ip4RoutingModule() = default;
+    Ip4RoutingModule();
 
     /**
      * Copy Constructor.
@@ -59,7 +58,7 @@ public:
     /**
      * Destructor.
      */
-    ~Ip4RoutingModule() = default;
+    ~Ip4RoutingModule();
 
     bool addRoute(const Util::Network::Ip4::Ip4Route &route);
 
@@ -67,16 +66,27 @@ public:
 
     void removeRoute(const Util::Network::Ip4::Ip4SubnetAddress &localAddress, const Util::String &device);
 
-    [[nodiscard]] const Util::Network::Ip4::Ip4Route& getDefaultRoute() const;
+    [[nodiscard]] Util::Network::Ip4::Ip4Route getDefaultRoute() const;
 
     [[nodiscard]] Util::Array<Util::Network::Ip4::Ip4Route> getRoutes(const Util::Network::Ip4::Ip4Address &sourceAddress);
 
-    [[nodiscard]] const Util::Network::Ip4::Ip4Route& findRoute(const Util::Network::Ip4::Ip4Address &sourceAddress, const Util::Network::Ip4::Ip4Address &address);
+    [[nodiscard]] Util::Network::Ip4::Ip4Route findRoute(const Util::Network::Ip4::Ip4Address &sourceAddress, const Util::Network::Ip4::Ip4Address &address);
 
 private:
 
-    Util::Network::Ip4::Ip4Route defaultRoute;
-    Util::ArrayList<Util::Network::Ip4::Ip4Route> routes;
+    struct RoutingTable {
+        Util::Array<Util::Network::Ip4::Ip4Route> routes;
+        Util::Network::Ip4::Ip4Route defaultRoute;
+    };
+
+    /**
+     * Replace the routing table with a copy, which has the given route added (or removed)
+     * and the given default route. Must be called with 'lock' held.
+     */
+    void updateRoutingTable(const Util::Network::Ip4::Ip4Route *addedRoute, const Util::Network::Ip4::Ip4Route *removedRoute, const Util::Network::Ip4::Ip4Route &defaultRoute);
+
+    // Published via read-copy-update, so that route lookups on the packet path do not need to lock
+    RoutingTable *volatile table;
     Util::Async::ReentrantSpinlock lock;
 };
 
@@ -132,10 +132,33 @@ PageDirectory::PageDirectory(PageDirectory &basePageDirectory) {
 PageDirectory::~PageDirectory() {
     auto &memoryService = System::getService<Kernel::MemoryService>();
 
-    // Free page tables corresponding to user space (< 3GB)
+    // Free page frames and page tables corresponding to user space (< 3GB).
+    // Only present tables are walked and their frames are returned to the page frame allocator in batches.
+    // This address space is not active anymore, so there is no need to lock the tables or to invalidate TLB entries.
+    uint32_t frames[FRAME_BATCH_SIZE];
     uint32_t maxIndex = MemoryLayout::KERNEL_START / (Paging::PAGESIZE * 1024);
     for (uint32_t index = 0; index < maxIndex; index++) {
-        memoryService.freePageTable((void *) virtualTableAddresses[index]);
+        if ((pageDirectory[index] & Paging::PRESENT) == 0) {
+            continue;
+        }
+
+        auto *table = reinterpret_cast<uint32_t*>(virtualTableAddresses[index]);
+        uint32_t frameCount = 0;
+        for (uint32_t i = 0; i < 1024; i++) {
+            if ((table[i] & Paging::PRESENT) == 0 || (table[i] & Paging::DO_NOT_UNMAP) != 0) {
+                continue;
+            }
+
+            frames[frameCount++] = table[i] & 0xFFFFF000;
+            if (frameCount == FRAME_BATCH_SIZE) {
+                memoryService.freePageFrames(frames, frameCount);
+                frameCount = 0;
+            }
+        }
+
+        memoryService.freePageFrames(frames, frameCount);
+        pageDirectory[index] = 0;
+        memoryService.freePageTable(table);
     }
 
     // Free page directory itself and list with virtual table addresses
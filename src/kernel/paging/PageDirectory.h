@@ -163,6 +163,9 @@ private:
 
     Util::Async::AtomicArray<uint8_t> lockArray = Util::Async::AtomicArray<uint8_t>(1024);
     uint32_t lockFree = 0xff;
+
+    // amount of page frames returned to the page frame allocator at once, when the directory is destroyed
+    static const constexpr uint32_t FRAME_BATCH_SIZE = 64;
 };
 
 }
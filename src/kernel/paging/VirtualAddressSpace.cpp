@@ -18,7 +18,7 @@
 #include "VirtualAddressSpace.h"
 #include "lib/util/base/Constants.h"
 #include "kernel/paging/PageDirectory.h"
-#include "lib/util/base/FreeListMemoryManager.h"
+#include "lib/util/base/HeapMemoryManager.h"
 
 namespace Util {
 
@@ -33,7 +33,7 @@ VirtualAddressSpace::VirtualAddressSpace(Util::HeapMemoryManager &kernelHeapMemo
 }
 
 VirtualAddressSpace::VirtualAddressSpace(PageDirectory &basePageDirectory) :
-        memoryManager(reinterpret_cast<Util::FreeListMemoryManager*>(Util::USER_SPACE_MEMORY_MANAGER_ADDRESS)), kernelAddressSpace(false) {
+        memoryManager(reinterpret_cast<Util::HeapMemoryManager*>(Util::USER_SPACE_MEMORY_MANAGER_ADDRESS)), kernelAddressSpace(false) {
     // Initialize a new memory abstraction through paging
     this->pageDirectory = new PageDirectory(basePageDirectory);
 }
@@ -20,8 +20,7 @@
 #include <cstdint>
 
 #include "lib/util/io/file/File.h"
-#include "lib/util/io/stream/FileInputStream.h"
-#include "lib/util/io/file/elf/File.h"
+#include "kernel/process/ExecutableImage.h"
 #include "kernel/system/System.h"
 #include "kernel/paging/Paging.h"
 #include "kernel/service/ProcessService.h"
@@ -30,6 +29,9 @@
 #include "kernel/service/SchedulerService.h"
 #include "lib/util/base/Exception.h"
 #include "lib/util/base/Address.h"
+#include "lib/util/base/Constants.h"
+#include "lib/util/collection/ArrayList.h"
+#include "lib/util/io/file/elf/DynamicObject.h"
 
 namespace Kernel {
 
@@ -46,16 +48,18 @@ void BinaryLoader::run() {
         Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "BinaryLoader: Not a file!");
     }
 
-    auto *buffer = new uint8_t[file.getLength()];
-    auto binaryStream = Util::Io::FileInputStream(file);
-    binaryStream.read(buffer, 0, file.getLength());
+    // Only the program headers are read here, the segments are loaded by the page fault handler on first access.
+    // Read-only pages, which have already been loaded by another process running the same executable, are shared.
+    auto &processService = System::getService<ProcessService>();
+    auto &process = processService.getCurrentProcess();
+    auto *executable = &processService.acquireExecutableImage(file.getCanonicalPath());
+    process.addExecutableImage(*executable);
 
-    // buffer is automatically deleted by file destructor
-    auto executable = Util::Io::Elf::File(buffer);
-    executable.loadProgram();
+    auto libraryInitializers = executable->getDynamicAddress() == 0 ? Util::Array<uint32_t>(0) : loadSharedLibraries(process, *executable);
 
     uint32_t argc = arguments.length() + 1;
-    char **argv = reinterpret_cast<char**>(executable.getEndAddress() + 1);
+    // Arguments start on the page after the executable, so that they never end up on a (possibly shared and write protected) segment page
+    char **argv = reinterpret_cast<char**>(Util::Address(executable->getEndAddress()).alignUp(Paging::PAGESIZE).get());
     auto currentAddress = reinterpret_cast<uint32_t>(argv) + sizeof(char**) * argc;
 
     for (uint32_t i = 0; i < argc; i++) {
@@ -67,14 +71,78 @@ void BinaryLoader::run() {
         currentAddress += targetArgument.stringLength() + 1;
     }
 
-    auto &processService = System::getService<ProcessService>();
+    // The initialization functions of shared libraries are called by crt0, before the program's own constructors.
+    // Dynamically linked programs always get a (possibly empty) list, which also tells crt0 not to clear .bss.
+    uint32_t *initializers = nullptr;
+    if (executable->getDynamicAddress() != 0) {
+        initializers = reinterpret_cast<uint32_t*>(Util::Address(currentAddress).alignUp(sizeof(uint32_t)).get());
+        for (uint32_t i = 0; i < libraryInitializers.length(); i++) {
+            initializers[i] = libraryInitializers[i];
+        }
+
+        initializers[libraryInitializers.length()] = 0;
+        currentAddress = reinterpret_cast<uint32_t>(initializers + libraryInitializers.length() + 1);
+    }
+
     auto &schedulerService = System::getService<SchedulerService>();
-    auto &process = processService.getCurrentProcess();
     auto heapAddress = Util::Address(currentAddress + 1).alignUp(Kernel::Paging::PAGESIZE).get();
-    auto &userThread = Thread::createMainUserThread(file.getName(), process, (uint32_t) executable.getEntryPoint(), argc, argv, nullptr, heapAddress);
+    auto &userThread = Thread::createMainUserThread(file.getName(), process, executable->getEntryPoint(), argc, argv, nullptr, heapAddress, initializers);
 
-    processService.getCurrentProcess().setMainThread(userThread);
+    process.setMainThread(userThread);
     schedulerService.ready(userThread);
 }
 
-}
\ No newline at end of file
+Util::Array<uint32_t> BinaryLoader::loadSharedLibraries(Process &process, ExecutableImage &executable) {
+    auto &processService = System::getService<ProcessService>();
+    Util::ArrayList<Util::Io::Elf::DynamicObject*> objects;
+    Util::ArrayList<Util::String> libraryNames;
+    objects.add(new Util::Io::Elf::DynamicObject(executable.getBaseAddress(), reinterpret_cast<const Util::Io::Elf::DynamicEntry*>(executable.getDynamicAddress())));
+
+    // Libraries are mapped one after another in breadth-first order. Most programs only depend on the same few libraries,
+    // so these usually end up at the same address in every process and their cached images (and read-only pages) are shared.
+    uint32_t loadAddress = Util::USER_SPACE_LIBRARY_AREA_START;
+    for (uint32_t i = 0; i < objects.size(); i++) {
+        for (const auto &name : objects.get(i)->getNeededLibraries()) {
+            if (libraryNames.contains(name)) {
+                continue;
+            }
+
+            auto &library = processService.acquireExecutableImage(Util::String(LIBRARY_PATH) + "/" + name, loadAddress);
+            process.addExecutableImage(library);
+
+            if (library.getEndAddress() > Util::USER_SPACE_LIBRARY_AREA_END) {
+                Util::Exception::throwException(Util::Exception::OUT_OF_MEMORY, "BinaryLoader: Shared libraries do not fit into the library area!");
+            }
+
+            if (library.getDynamicAddress() == 0) {
+                Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "BinaryLoader: Not a shared library!");
+            }
+
+            libraryNames.add(name);
+            objects.add(new Util::Io::Elf::DynamicObject(library.getBaseAddress(), reinterpret_cast<const Util::Io::Elf::DynamicEntry*>(library.getDynamicAddress())));
+            loadAddress = Util::Address(library.getEndAddress()).alignUp(Paging::PAGESIZE).get();
+        }
+    }
+
+    // Symbols are resolved in load order (executable first), but dependencies are relocated and initialized first,
+    // so that copy relocations and constructors see fully relocated data.
+    auto scope = objects.toArray();
+    for (uint32_t i = scope.length(); i > 0; i--) {
+        scope[i - 1]->relocate(scope);
+    }
+
+    Util::ArrayList<uint32_t> initializers;
+    for (uint32_t i = scope.length() - 1; i > 0; i--) {
+        for (auto initializer : scope[i]->getInitializers()) {
+            initializers.add(initializer);
+        }
+    }
+
+    for (auto *object : scope) {
+        delete object;
+    }
+
+    return initializers.toArray();
+}
+
+}
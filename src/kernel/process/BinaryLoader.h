@@ -23,6 +23,8 @@
 #include "lib/util/collection/Array.h"
 
 namespace Kernel {
+class ExecutableImage;
+class Process;
 
 class BinaryLoader : public Util::Async::Runnable {
 
@@ -49,8 +51,18 @@ public:
 
     void run() override;
 
+    static const constexpr char *LIBRARY_PATH = "/initrd/lib";
+
 private:
 
+    /**
+     * Map all shared libraries needed by a dynamically linked executable (and their dependencies),
+     * relocate them and bind all symbols immediately.
+     *
+     * @return The initialization functions of all libraries, ordered so that dependencies are initialized first
+     */
+    static Util::Array<uint32_t> loadSharedLibraries(Process &process, ExecutableImage &executable);
+
     const Util::String path;
     const Util::String command;
     const Util::Array<Util::String> arguments;
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "ExecutableImage.h"
+
+#include "filesystem/core/Node.h"
+#include "kernel/paging/Paging.h"
+#include "lib/util/base/Address.h"
+#include "lib/util/base/Exception.h"
+#include "lib/util/io/file/elf/File.h"
+#include "lib/util/async/Atomic.h"
+#include "kernel/system/System.h"
+#include "kernel/service/MemoryService.h"
+
+namespace Kernel {
+
+ExecutableImage::ExecutableImage(const Util::String &path, Filesystem::Node *node, uint32_t loadAddress) : path(path), length(node->getLength()), node(node), segments(0) {
+    Util::Io::Elf::FileHeader fileHeader{};
+    if (node->readData(reinterpret_cast<uint8_t*>(&fileHeader), 0, sizeof(fileHeader)) != sizeof(fileHeader) || !fileHeader.isValid()) {
+        Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Elf: Invalid file!");
+    }
+
+    if (fileHeader.programHeaderEntrySize != sizeof(Util::Io::Elf::ProgramHeader)) {
+        Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Elf: Unsupported program header size!");
+    }
+
+    auto *programHeaders = new Util::Io::Elf::ProgramHeader[fileHeader.programHeaderEntries];
+    uint32_t programHeaderSize = fileHeader.programHeaderEntries * sizeof(Util::Io::Elf::ProgramHeader);
+    if (node->readData(reinterpret_cast<uint8_t*>(programHeaders), fileHeader.programHeader, programHeaderSize) != programHeaderSize) {
+        delete[] programHeaders;
+        Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Elf: Invalid file!");
+    }
+
+    uint32_t segmentCount = 0;
+    uint32_t linkAddress = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < fileHeader.programHeaderEntries; i++) {
+        if (programHeaders[i].type == Util::Io::Elf::ProgramHeaderType::LOAD) {
+            segmentCount++;
+            if (programHeaders[i].virtualAddress < linkAddress) {
+                linkAddress = programHeaders[i].virtualAddress;
+            }
+        }
+    }
+
+    // Shared objects are position independent and can be mapped at any page aligned address
+    if (fileHeader.type == Util::Io::Elf::ElfType::DYNAMIC && segmentCount > 0) {
+        baseAddress = loadAddress - (linkAddress & 0xFFFFF000);
+    }
+
+    segments = Util::Array<Segment>(segmentCount);
+    for (uint32_t i = 0, j = 0; i < fileHeader.programHeaderEntries; i++) {
+        const auto &header = programHeaders[i];
+        if (header.type == Util::Io::Elf::ProgramHeaderType::DYNAMIC) {
+            dynamicAddress = baseAddress + header.virtualAddress;
+        }
+
+        if (header.type != Util::Io::Elf::ProgramHeaderType::LOAD) {
+            continue;
+        }
+
+        bool writable = (header.flags & Util::Io::Elf::ProgramHeaderFlag::WRITABLE) != 0;
+        uint32_t virtualAddress = baseAddress + header.virtualAddress;
+        uint32_t *sharedFrames = nullptr;
+        if (!writable) {
+            uint32_t pageCount = ((virtualAddress + header.memorySize + Paging::PAGESIZE - 1) / Paging::PAGESIZE) - virtualAddress / Paging::PAGESIZE;
+            sharedFrames = new uint32_t[pageCount];
+            Util::Address<uint32_t>(sharedFrames).setRange(0, pageCount * sizeof(uint32_t));
+        }
+
+        segments[j++] = Segment{virtualAddress, header.memorySize, header.offset, header.fileSize, writable, sharedFrames};
+        if (virtualAddress + header.memorySize > endAddress) {
+            endAddress = virtualAddress + header.memorySize;
+        }
+    }
+
+    entryPoint = baseAddress + fileHeader.entry;
+    delete[] programHeaders;
+}
+
+ExecutableImage::~ExecutableImage() {
+    auto &memoryService = System::getService<MemoryService>();
+    for (const auto &segment : segments) {
+        if (segment.sharedFrames == nullptr) {
+            continue;
+        }
+
+        // Drop the references held by this image (pages still mapped by a process are freed on its teardown)
+        uint32_t pageCount = ((segment.virtualAddress + segment.memorySize + Paging::PAGESIZE - 1) / Paging::PAGESIZE) - segment.virtualAddress / Paging::PAGESIZE;
+        for (uint32_t i = 0; i < pageCount; i++) {
+            if (segment.sharedFrames[i] != 0) {
+                memoryService.freePageFrames(&segment.sharedFrames[i], 1);
+            }
+        }
+
+        delete[] segment.sharedFrames;
+    }
+
+    delete node;
+}
+
+uint32_t ExecutableImage::getEntryPoint() const {
+    return entryPoint;
+}
+
+uint32_t ExecutableImage::getEndAddress() const {
+    return endAddress;
+}
+
+uint32_t ExecutableImage::getBaseAddress() const {
+    return baseAddress;
+}
+
+uint32_t ExecutableImage::getDynamicAddress() const {
+    return dynamicAddress;
+}
+
+bool ExecutableImage::contains(uint32_t virtualAddress) const {
+    // Segments are loaded page by page, so the whole first and last page of a segment belong to it
+    uint32_t pageAddress = virtualAddress & 0xFFFFF000;
+    for (const auto &segment : segments) {
+        if (segment.memorySize > 0 && pageAddress >= (segment.virtualAddress & 0xFFFFF000) && pageAddress < segment.virtualAddress + segment.memorySize) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ExecutableImage::loadPage(uint32_t pageAddress) {
+    // Page frames are not cleared by the page frame allocator, so everything not backed by the file must be zeroed
+    Util::Address<uint32_t>(pageAddress).setRange(0, Paging::PAGESIZE);
+
+    for (const auto &segment : segments) {
+        // Only the part of the segment, that is stored in the file, needs to be read (the rest is .bss)
+        uint32_t start = segment.virtualAddress > pageAddress ? segment.virtualAddress : pageAddress;
+        uint32_t end = segment.virtualAddress + segment.fileSize < pageAddress + Paging::PAGESIZE ? segment.virtualAddress + segment.fileSize : pageAddress + Paging::PAGESIZE;
+        if (start >= end) {
+            continue;
+        }
+
+        node->readData(reinterpret_cast<uint8_t*>(start), segment.fileOffset + (start - segment.virtualAddress), end - start);
+    }
+}
+
+bool ExecutableImage::isShareable(uint32_t pageAddress) const {
+    return findSharingSegment(pageAddress) != nullptr;
+}
+
+uint32_t ExecutableImage::getSharedFrame(uint32_t pageAddress) const {
+    const auto *segment = findSharingSegment(pageAddress);
+    if (segment == nullptr) {
+        return 0;
+    }
+
+    auto &frame = segment->sharedFrames[(pageAddress - (segment->virtualAddress & 0xFFFFF000)) / Paging::PAGESIZE];
+    return Util::Async::Atomic<uint32_t>(frame).get();
+}
+
+bool ExecutableImage::publishSharedFrame(uint32_t pageAddress, uint32_t physicalAddress) {
+    const auto *segment = findSharingSegment(pageAddress);
+    if (segment == nullptr) {
+        return false;
+    }
+
+    auto &frame = segment->sharedFrames[(pageAddress - (segment->virtualAddress & 0xFFFFF000)) / Paging::PAGESIZE];
+    return Util::Async::Atomic<uint32_t>(frame).compareAndSet(0, physicalAddress);
+}
+
+const ExecutableImage::Segment* ExecutableImage::findSharingSegment(uint32_t pageAddress) const {
+    // The frame of a page is recorded by the first segment overlapping it.
+    // Pages overlapping a writable segment are never shared, since each process needs its own copy of the data.
+    const Segment *ret = nullptr;
+    for (const auto &segment : segments) {
+        if (segment.memorySize == 0 || segment.virtualAddress >= pageAddress + Paging::PAGESIZE || segment.virtualAddress + segment.memorySize <= pageAddress) {
+            continue;
+        }
+
+        if (segment.writable) {
+            return nullptr;
+        }
+
+        if (ret == nullptr) {
+            ret = &segment;
+        }
+    }
+
+    return ret;
+}
+
+bool ExecutableImage::isIdentical(const ExecutableImage &other) const {
+    if (path != other.path || length != other.length || entryPoint != other.entryPoint || segments.length() != other.segments.length()) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < segments.length(); i++) {
+        const auto &segment = segments[i];
+        const auto &otherSegment = other.segments[i];
+        if (segment.virtualAddress != otherSegment.virtualAddress || segment.memorySize != otherSegment.memorySize ||
+            segment.fileOffset != otherSegment.fileOffset || segment.fileSize != otherSegment.fileSize || segment.writable != otherSegment.writable) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ExecutableImage::acquire() {
+    Util::Async::Atomic<uint32_t>(references).inc();
+}
+
+void ExecutableImage::release() {
+    Util::Async::Atomic<uint32_t>(references).dec();
+}
+
+bool ExecutableImage::isReferenced() const {
+    return Util::Async::Atomic<uint32_t>(const_cast<uint32_t&>(references)).get() > 0;
+}
+
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_EXECUTABLEIMAGE_H
+#define HHUOS_EXECUTABLEIMAGE_H
+
+#include <cstdint>
+
+#include "lib/util/collection/Array.h"
+#include "lib/util/base/String.h"
+
+namespace Filesystem {
+class Node;
+}  // namespace Filesystem
+
+namespace Kernel {
+
+/**
+ * Loadable segments of an ELF executable, which are mapped into a process' address space on demand.
+ *
+ * Only the file header and program headers are read, when the image is created.
+ * The contents of a segment are read from the file node by the page fault handler (see MemoryService::trigger()),
+ * when one of its pages is accessed for the first time. Memory behind the file contents of a segment (.bss) is zero-filled.
+ *
+ * Images are cached by the ProcessService and shared by all processes running the same executable.
+ * Pages, which only belong to read-only segments (e.g. .text and .rodata), are loaded once and their page frames
+ * are mapped into every process using the image. The image holds an additional reference (use count) on these frames,
+ * so they survive the processes and are only freed, when the image is evicted from the cache.
+ *
+ * Shared libraries (ET_DYN) are moved to the load address given on construction. Since they are compiled
+ * as position independent code, their read-only pages need no relocation and can be shared just like the
+ * pages of an executable. Relocating the writable data is left to the BinaryLoader.
+ */
+class ExecutableImage {
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param node The executable file (the image takes ownership of the node)
+     * @param loadAddress The address, at which a shared object (ET_DYN) is mapped (ignored for executables)
+     */
+    ExecutableImage(const Util::String &path, Filesystem::Node *node, uint32_t loadAddress = 0);
+
+    /**
+     * Copy Constructor.
+     */
+    ExecutableImage(const ExecutableImage &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    ExecutableImage &operator=(const ExecutableImage &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~ExecutableImage();
+
+    [[nodiscard]] uint32_t getEntryPoint() const;
+
+    [[nodiscard]] uint32_t getEndAddress() const;
+
+    /**
+     * Get the offset, which has been added to all addresses of a shared object (0 for executables).
+     */
+    [[nodiscard]] uint32_t getBaseAddress() const;
+
+    /**
+     * Get the address of the dynamic section (PT_DYNAMIC).
+     *
+     * @return The address, or 0 if the file is statically linked
+     */
+    [[nodiscard]] uint32_t getDynamicAddress() const;
+
+    /**
+     * Check if a virtual address lies on a page, which overlaps one of the loadable segments.
+     * Such pages must be filled by loadPage(), since parts of them may be backed by the file or be zeroed .bss.
+     */
+    [[nodiscard]] bool contains(uint32_t virtualAddress) const;
+
+    /**
+     * Fill an already mapped page with the contents of all segments overlapping it.
+     *
+     * @param pageAddress The page aligned virtual address of the page
+     */
+    void loadPage(uint32_t pageAddress);
+
+    /**
+     * Check if a page only belongs to read-only segments and may thus be shared between processes.
+     */
+    [[nodiscard]] bool isShareable(uint32_t pageAddress) const;
+
+    /**
+     * Get the physical address of an already loaded shareable page.
+     *
+     * @return The physical address, or 0 if the page has not been loaded yet
+     */
+    [[nodiscard]] uint32_t getSharedFrame(uint32_t pageAddress) const;
+
+    /**
+     * Offer a loaded page frame for a shareable page to other processes.
+     * The caller must hold a reference on the frame on behalf of the image.
+     *
+     * @return false, if another frame has been published for the page in the meantime
+     */
+    bool publishSharedFrame(uint32_t pageAddress, uint32_t physicalAddress);
+
+    /**
+     * Check if this image has been created from the same, unmodified executable file as another image.
+     * The filesystem provides no modification time, so the file length and the program headers are compared.
+     */
+    [[nodiscard]] bool isIdentical(const ExecutableImage &other) const;
+
+    void acquire();
+
+    void release();
+
+    [[nodiscard]] bool isReferenced() const;
+
+private:
+
+    struct Segment {
+        uint32_t virtualAddress;
+        uint32_t memorySize;
+        uint32_t fileOffset;
+        uint32_t fileSize;
+        bool writable;
+        // Physical addresses of loaded pages (only for read-only segments)
+        uint32_t *sharedFrames;
+    };
+
+    [[nodiscard]] const Segment* findSharingSegment(uint32_t pageAddress) const;
+
+    Util::String path;
+    uint64_t length;
+    Filesystem::Node *node;
+    Util::Array<Segment> segments;
+    uint32_t references = 0;
+    uint32_t entryPoint = 0;
+    uint32_t endAddress = 0;
+    uint32_t baseAddress = 0;
+    uint32_t dynamicAddress = 0;
+};
+
+}
+
+#endif
@@ -19,20 +19,26 @@
 #include "Process.h"
 #include "kernel/paging/VirtualAddressSpace.h"
 #include "kernel/process/Thread.h"
+#include "kernel/process/ExecutableImage.h"
 #include "kernel/service/MemoryService.h"
 #include "kernel/service/SchedulerService.h"
 #include "lib/util/async/IdGenerator.h"
 #include "lib/util/collection/Iterator.h"
+#include "lib/util/base/Constants.h"
+#include "lib/util/base/Exception.h"
 
 namespace Kernel {
 
 Util::Async::IdGenerator<uint32_t> Process::idGenerator;
 
 Process::Process(VirtualAddressSpace &addressSpace, const Util::String &name, const Util::Io::File &workingDirectory) :
-        id(idGenerator.next()), name(name), addressSpace(addressSpace), workingDirectory(workingDirectory) {}
+        id(idGenerator.next()), name(name), addressSpace(addressSpace), workingDirectory(workingDirectory), userStackSlots(Util::MAX_USER_STACKS) {}
 
 Process::~Process() {
     Kernel::System::getService<Kernel::MemoryService>().removeAddressSpace(addressSpace);
+    for (auto *image : executableImages) {
+        image->release();
+    }
 }
 
 bool Process::operator==(const Process &other) const {
@@ -98,6 +104,21 @@ void Process::setMainThread(Thread &thread) {
     mainThread = &thread;
 }
 
+void Process::addExecutableImage(ExecutableImage &image) {
+    executableImages.add(&image);
+}
+
+ExecutableImage* Process::getExecutableImage(uint32_t virtualAddress) const {
+    for (uint32_t i = 0; i < executableImages.size(); i++) {
+        auto *image = executableImages.get(i);
+        if (image->contains(virtualAddress)) {
+            return image;
+        }
+    }
+
+    return nullptr;
+}
+
 void Process::join() {
     auto &schedulerService = System::getService<Kernel::SchedulerService>();
     while (mainThread == nullptr) {
@@ -127,6 +148,19 @@ void Process::removeThread(Thread &thread) {
     threads.remove(&thread);
 }
 
+uint32_t Process::allocateUserStackSlot() {
+    uint32_t slot = userStackSlots.findAndSet();
+    if (slot == Util::Async::AtomicBitmap::INVALID_INDEX) {
+        Util::Exception::throwException(Util::Exception::OUT_OF_MEMORY, "Process: No free user stack available!");
+    }
+
+    return slot;
+}
+
+void Process::freeUserStackSlot(uint32_t slot) {
+    userStackSlots.unset(slot);
+}
+
 void Process::killAllThreadsButCurrent() {
     auto &schedulerService = System::getService<SchedulerService>();
     auto currentThreadId = schedulerService.getCurrentThread().getId();
@@ -26,6 +26,7 @@
 #include "lib/util/collection/ArrayList.h"
 #include "lib/util/base/String.h"
 #include "kernel/process/Thread.h"
+#include "lib/util/async/AtomicBitmap.h"
 
 namespace Util {
 namespace Async {
@@ -35,6 +36,7 @@ template <typename T> class IdGenerator;
 
 namespace Kernel {
 class VirtualAddressSpace;
+class ExecutableImage;
 
 class Process {
 
@@ -67,6 +69,19 @@ public:
 
     void setMainThread(Thread &thread);
 
+    /**
+     * Add an executable or shared library, whose segments are mapped into this process on demand.
+     * The process releases its reference on the image, when it is destroyed.
+     */
+    void addExecutableImage(ExecutableImage &image);
+
+    /**
+     * Get the executable or shared library, which contains a virtual address.
+     *
+     * @return The image, or nullptr if the address does not belong to any loaded image
+     */
+    [[nodiscard]] ExecutableImage* getExecutableImage(uint32_t virtualAddress) const;
+
     void join();
 
     [[nodiscard]] uint32_t getId() const;
@@ -95,6 +110,15 @@ public:
 
     void killAllThreadsButCurrent();
 
+    /**
+     * Reserve one of the user stack slots in this process' address space (see Util::USER_SPACE_STACK_AREA_START).
+     *
+     * @return The slot number
+     */
+    [[nodiscard]] uint32_t allocateUserStackSlot();
+
+    void freeUserStackSlot(uint32_t slot);
+
 private:
 
     [[nodiscard]] Util::Io::File getFileFromPath(const Util::String &path);
@@ -106,6 +130,8 @@ private:
     Util::Io::File workingDirectory;
     Util::ArrayList<Thread*> threads;
     Thread *mainThread = nullptr;
+    Util::ArrayList<ExecutableImage*> executableImages;
+    Util::Async::AtomicBitmap userStackSlots;
 
     bool finished = false;
     int32_t exitCode = -1;
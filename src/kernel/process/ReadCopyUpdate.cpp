@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "ReadCopyUpdate.h"
+
+#include "lib/util/async/Atomic.h"
+#include "lib/util/async/Thread.h"
+
+namespace Kernel {
+
+uint32_t ReadCopyUpdate::epoch = 0;
+uint32_t ReadCopyUpdate::readers[2]{};
+ReadCopyUpdate::RetiredObject *ReadCopyUpdate::retiredObjects = nullptr;
+Util::Async::Spinlock ReadCopyUpdate::synchronizeLock("ReadCopyUpdate");
+
+uint32_t ReadCopyUpdate::readLock() {
+    uint32_t token = epoch & 0x01;
+    // The locked increment is a full memory barrier, so protected pointers are loaded afterwards
+    Util::Async::Atomic<uint32_t>(readers[token]).inc();
+
+    return token;
+}
+
+void ReadCopyUpdate::readUnlock(uint32_t token) {
+    Util::Async::Atomic<uint32_t>(readers[token]).dec();
+}
+
+void ReadCopyUpdate::synchronize() {
+    synchronizeLock.acquire();
+
+    for (uint32_t i = 0; i < 2; i++) {
+        auto oldEpoch = Util::Async::Atomic<uint32_t>(epoch).fetchAndInc();
+        while (Util::Async::Atomic<uint32_t>(readers[oldEpoch & 0x01]).get() != 0) {
+            Util::Async::Thread::yield();
+        }
+    }
+
+    synchronizeLock.release();
+}
+
+void ReadCopyUpdate::reclaim() {
+    auto &head = reinterpret_cast<uint32_t&>(retiredObjects);
+    if (Util::Async::Atomic<uint32_t>(head).get() == 0) {
+        return;
+    }
+
+    // Detach the list, objects retired from now on are reclaimed in the next round
+    auto *objects = reinterpret_cast<RetiredObject*>(Util::Async::Atomic<uint32_t>(head).getAndSet(0));
+    synchronize();
+
+    while (objects != nullptr) {
+        auto *next = objects->next;
+        objects->destructor(objects->object);
+        delete objects;
+        objects = next;
+    }
+}
+
+void ReadCopyUpdate::retire(void *object, void (*destructor)(void *object)) {
+    auto *retiredObject = new RetiredObject{object, destructor, nullptr};
+    auto &head = reinterpret_cast<uint32_t&>(retiredObjects);
+
+    uint32_t oldHead;
+    do {
+        oldHead = Util::Async::Atomic<uint32_t>(head).get();
+        retiredObject->next = reinterpret_cast<RetiredObject*>(oldHead);
+    } while (!Util::Async::Atomic<uint32_t>(head).compareAndSet(oldHead, reinterpret_cast<uint32_t>(retiredObject)));
+}
+
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_READCOPYUPDATE_H
+#define HHUOS_READCOPYUPDATE_H
+
+#include <cstdint>
+
+#include "lib/util/async/Spinlock.h"
+
+namespace Kernel {
+
+/**
+ * Epoch based read-copy-update synchronization for read-mostly data (e.g. mount tables and routing tables).
+ *
+ * Readers enclose their accesses in readLock()/readUnlock() and load shared pointers via read().
+ * They never block and may sleep inside a read section.
+ * Writers serialize among themselves with their own lock, publish a modified copy via publish()
+ * and hand the old version to retire(). Retired objects are deleted by the scheduler cleaner thread,
+ * once all read sections, which might still reference them, have ended.
+ *
+ * Readers are counted per epoch. A grace period advances the epoch twice and waits for the reader count
+ * of the respective previous epoch to drop to zero, which covers readers that have been preempted
+ * between reading the epoch and incrementing its counter.
+ */
+class ReadCopyUpdate {
+
+public:
+    /**
+     * Default Constructor.
+     * Deleted, as this class has only static members.
+     */
+    ReadCopyUpdate() = delete;
+
+    /**
+     * Copy Constructor.
+     */
+    ReadCopyUpdate(const ReadCopyUpdate &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    ReadCopyUpdate &operator=(const ReadCopyUpdate &other) = delete;
+
+    /**
+     * Destructor.
+     * Deleted, as this class has only static members.
+     */
+    ~ReadCopyUpdate() = delete;
+
+    /**
+     * Enter a read section.
+     *
+     * @return A token, which must be passed to readUnlock()
+     */
+    static uint32_t readLock();
+
+    /**
+     * Leave a read section. Pointers loaded inside the section must not be used afterwards.
+     *
+     * @param token The token returned by the matching readLock() call
+     */
+    static void readUnlock(uint32_t token);
+
+    /**
+     * Load a pointer, which is protected by read-copy-update, inside a read section.
+     */
+    template<typename T>
+    static T* read(T *const volatile &pointer);
+
+    /**
+     * Replace a pointer, which is protected by read-copy-update. The new object must be fully initialized.
+     */
+    template<typename T>
+    static void publish(T *volatile &pointer, T *value);
+
+    /**
+     * Delete an object after a grace period. The object must not be reachable for new readers anymore.
+     */
+    template<typename T>
+    static void retire(T *object);
+
+    /**
+     * Wait until all read sections, which have been entered before this call, have ended.
+     * Must not be called inside a read section.
+     */
+    static void synchronize();
+
+    /**
+     * Delete all objects, which have been retired before this call.
+     * Called periodically by the SchedulerCleaner.
+     */
+    static void reclaim();
+
+private:
+
+    struct RetiredObject {
+        void *object;
+        void (*destructor)(void *object);
+        RetiredObject *next;
+    };
+
+    static void retire(void *object, void (*destructor)(void *object));
+
+    static uint32_t epoch;
+    static uint32_t readers[2];
+    static RetiredObject *retiredObjects;
+    static Util::Async::Spinlock synchronizeLock;
+};
+
+template<typename T>
+T* ReadCopyUpdate::read(T *const volatile &pointer) {
+    // Aligned 32-bit loads are atomic; The compiler barrier prevents hoisting the load out of the read section
+    auto *ret = pointer;
+    asm volatile("" ::: "memory");
+    return ret;
+}
+
+template<typename T>
+void ReadCopyUpdate::publish(T *volatile &pointer, T *value) {
+    // Stores are not reordered with older stores on x86, so readers always see an initialized object
+    asm volatile("" ::: "memory");
+    pointer = value;
+}
+
+template<typename T>
+void ReadCopyUpdate::retire(T *object) {
+    if (object == nullptr) {
+        return;
+    }
+
+    retire(object, [](void *object) {
+        delete static_cast<T*>(object);
+    });
+}
+
+}
+
+#endif
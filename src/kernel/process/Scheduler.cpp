@@ -25,9 +25,14 @@
 #include "kernel/process/Thread.h"
 #include "kernel/service/MemoryService.h"
 #include "kernel/service/SchedulerService.h"
+#include "lib/util/async/Atomic.h"
 #include "lib/util/base/Exception.h"
 #include "lib/util/time/Timestamp.h"
 #include "lib/util/collection/Iterator.h"
+#include "device/cpu/Cpu.h"
+#include "device/time/ApicTimer.h"
+#include "device/interrupt/apic/Apic.h"
+#include "kernel/service/InterruptService.h"
 
 extern uint32_t scheduler_initialized;
 
@@ -42,14 +47,20 @@ Scheduler::~Scheduler() {
 }
 
 void Scheduler::start() {
+    auto &interruptService = System::getService<InterruptService>();
+    if (interruptService.usesApic() && Device::ApicTimer::isHighResolutionAvailable()) {
+        // There is only one scheduler, which is driven by the bootstrap processor's timer
+        highResolutionTimer = &interruptService.getApic().getCurrentTimer();
+    }
+
     lock.acquire();
-    currentThread = &getNextThread();
-    start_first_thread(currentThread->getContext());
+    currentThread.set(&getNextThread());
+    start_first_thread(currentThread.get()->getContext());
 }
 
 void Scheduler::ready(Thread &thread) {
-    if (currentThread == nullptr) {
-        currentThread = &thread;
+    if (currentThread.get() == nullptr) {
+        currentThread.set(&thread);
     }
 
     if (threadQueue.contains(&thread)) {
@@ -63,53 +74,49 @@ void Scheduler::ready(Thread &thread) {
 }
 
 void Scheduler::exit() {
+    auto *thread = currentThread.get();
+
     lock.acquire();
-    threadQueue.remove(currentThread);
-    currentThread->getParent().removeThread(*currentThread);
+    threadQueue.remove(thread);
+    thread->getParent().removeThread(*thread);
     lock.release();
 
-    currentThread->unblockJoinList();
+    thread->unblockJoinList();
 
-    System::getService<SchedulerService>().cleanup(currentThread);
+    System::getService<SchedulerService>().cleanup(thread);
     yield(true);
 }
 
 void Scheduler::kill(Thread &thread) {
-    if (thread.getId() == currentThread->getId()) {
+    if (thread.getId() == currentThread.get()->getId()) {
         Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT,"Scheduler: A thread cannot kill itself!");
     }
 
-    sleepLock.acquire();
-    sleepList.remove(SleepEntry{&thread, 0});
-    sleepLock.release();
-
     lock.acquire();
-    threadQueue.remove(&thread);
-    thread.getParent().removeThread(thread);
-    thread.unblockJoinList();
+    killWithoutLock(thread);
     lock.release();
-
-    System::getService<SchedulerService>().cleanup(&thread);
 }
 
 void Scheduler::killWithoutLock(Thread &thread) {
-    if (thread.getId() == currentThread->getId()) {
+    if (thread.getId() == currentThread.get()->getId()) {
         Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT,"Scheduler: A thread cannot kill itself!");
     }
 
+    if (Util::Async::Atomic<uint32_t>(thread.lockWaits).get() > 0) {
+        // The thread would never take its turn in the lock's queue -> Let it run, until it has left the queue (see reschedule())
+        thread.killPending = true;
+        return;
+    }
+
     sleepLock.acquire();
     sleepList.remove(SleepEntry{&thread, 0});
     sleepLock.release();
 
-    threadQueue.remove(&thread);
-    thread.getParent().removeThread(thread);
-    thread.unblockJoinList();
-
-    System::getService<SchedulerService>().cleanup(&thread);
+    removeThread(thread);
 }
 
 Thread& Scheduler::getCurrentThread() {
-    return *currentThread;
+    return *currentThread.get();
 }
 
 Thread& Scheduler::getNextThread() {
@@ -130,19 +137,39 @@ void Scheduler::yield(bool force) {
         return;
     }
 
-    do {
-        checkSleepList();
-    } while (threadQueue.isEmpty());
+    reschedule();
+}
 
-    Thread &nextThread = getNextThread();
+void Scheduler::reschedule() {
+    Thread *nextThread = nullptr;
+    while (nextThread == nullptr) {
+        do {
+            checkSleepList();
+        } while (threadQueue.isEmpty());
+
+        nextThread = &getNextThread();
+        if (nextThread->killPending && Util::Async::Atomic<uint32_t>(nextThread->lockWaits).get() == 0) {
+            // The thread has been killed, while it was queued in a lock (see killWithoutLock()) -> Kill it now
+            removeThread(*nextThread);
+            nextThread = nullptr;
+        }
+    }
+
+    System::getService<Kernel::MemoryService>().switchAddressSpace(nextThread->getParent().getAddressSpace());
+    dispatch(*nextThread);
+}
+
+void Scheduler::removeThread(Thread &thread) {
+    threadQueue.remove(&thread);
+    thread.getParent().removeThread(thread);
+    thread.unblockJoinList();
 
-    System::getService<Kernel::MemoryService>().switchAddressSpace(nextThread.getParent().getAddressSpace());
-    dispatch(nextThread);
+    System::getService<SchedulerService>().cleanup(&thread);
 }
 
 void Scheduler::dispatch(Thread &nextThread) {
-    auto &oldThread = *currentThread;
-    currentThread = &nextThread;
+    auto &oldThread = *currentThread.get();
+    currentThread.set(&nextThread);
     if (fpuAvailable) {
         Device::Fpu::armFpuMonitor();
     }
@@ -156,7 +183,7 @@ uint32_t Scheduler::getThreadCount() const {
 
 void Scheduler::block() {
     lock.acquire();
-    threadQueue.remove(currentThread);
+    threadQueue.remove(currentThread.get());
     lock.release();
 
     yield(true);
@@ -169,29 +196,50 @@ void Scheduler::unblock(Thread &thread) {
 }
 
 void Scheduler::sleep(const Util::Time::Timestamp &time) {
-    auto systemTime = System::getService<TimeService>().getSystemTime().toMilliseconds();
+    auto wakeupTime = getWakeupClock() + (highResolutionTimer == nullptr ? time.toMilliseconds() : Device::ApicTimer::toTimestampCounterTicks(time));
+    auto *thread = currentThread.get();
+
+    // Holding the scheduler lock until the next thread runs prevents the sleep list from waking us up, before we are blocked
+    lock.acquire();
+    threadQueue.remove(thread);
 
     sleepLock.acquire();
-    sleepList.add(SleepEntry{currentThread, systemTime + time.toMilliseconds()});
+    uint32_t index = 0;
+    while (index < sleepList.size() && sleepList.get(index).wakeupTime <= wakeupTime) {
+        index++;
+    }
+
+    sleepList.add(index, SleepEntry{thread, wakeupTime});
+    if (index == 0 && highResolutionTimer != nullptr) {
+        highResolutionTimer->setDeadline(wakeupTime);
+    }
     sleepLock.release();
 
-    block();
+    reschedule();
 }
 
 void Scheduler::checkSleepList() {
     if (sleepLock.tryAcquire()) {
-        auto systemTime = System::getService<TimeService>().getSystemTime().toMilliseconds();
-        for (uint32_t i = 0; i < sleepList.size(); i++) {
-            const auto &entry = sleepList.get(i);
-            if (systemTime >= entry.wakeupTime) {
-                threadQueue.offer(entry.thread);
-                sleepList.remove(entry);
-            }
+        auto now = getWakeupClock();
+        while (!sleepList.isEmpty() && sleepList.get(0).wakeupTime <= now) {
+            threadQueue.offer(sleepList.removeIndex(0).thread);
+        }
+
+        if (highResolutionTimer != nullptr) {
+            highResolutionTimer->setDeadline(sleepList.isEmpty() ? Device::ApicTimer::NO_DEADLINE : sleepList.get(0).wakeupTime);
         }
         sleepLock.release();
     }
 }
 
+uint64_t Scheduler::getWakeupClock() const {
+    if (highResolutionTimer != nullptr) {
+        return Device::Cpu::readTimestampCounter();
+    }
+
+    return System::getService<TimeService>().getSystemTime().toMilliseconds();
+}
+
 Thread* Scheduler::getThread(uint32_t id) {
     lock.acquire();
     sleepLock.acquire();
@@ -21,15 +21,20 @@
 #include <cstdint>
 
 #include "lib/util/collection/ArrayListBlockingQueue.h"
-#include "lib/util/async/Spinlock.h"
+#include "lib/util/async/McsSpinlock.h"
+#include "lib/util/async/TicketSpinlock.h"
 #include "lib/util/collection/ArrayList.h"
 #include "kernel/process/Thread.h"
+#include "kernel/system/PerCpu.h"
 
 namespace Util {
 namespace Time {
 class Timestamp;
 }  // namespace Time
 }  // namespace Util
+namespace Device {
+class ApicTimer;
+}  // namespace Device
 
 namespace Kernel {
 
@@ -76,6 +81,7 @@ public:
 
     /**
      * Kills a specific Thread.
+     * A thread, which is queued in a fair lock, is only marked and killed by the scheduler, once it has left the queue.
      *
      * @param thread A Thread
      */
@@ -110,23 +116,47 @@ private:
      */
     void dispatch(Thread &nextThread);
 
+    /**
+     * Switch to the next ready thread. Must be called with the scheduler lock held,
+     * which is released by the next thread.
+     */
+    void reschedule();
+
+    /**
+     * Remove a killed thread from the ready queue and its process and hand it over to the SchedulerCleaner.
+     * Must be called with the scheduler lock held.
+     */
+    void removeThread(Thread &thread);
+
+    /**
+     * Move all threads, whose wakeup time has passed, from the sleep list to the ready queue
+     * and arm the high resolution timer for the next wakeup time.
+     */
     void checkSleepList();
 
+    /**
+     * Get the current wakeup time base. This is the time stamp counter, if high resolution timing is available
+     * and the system time in milliseconds otherwise.
+     */
+    [[nodiscard]] uint64_t getWakeupClock() const;
+
 private:
 
     struct SleepEntry {
         Thread *thread;
-        uint32_t wakeupTime;
+        uint64_t wakeupTime;
 
         bool operator!=(const SleepEntry &other) const;
     };
 
-    Util::Async::Spinlock lock;
-    Util::Async::Spinlock sleepLock;
+    Util::Async::McsSpinlock lock{"Scheduler"};
+    Util::Async::TicketSpinlock sleepLock{"Scheduler.sleep"};
 
     Util::ArrayListBlockingQueue<Thread*> threadQueue;
+    // Sorted by wakeup time, so that only the first entry needs to be checked and armed
     Util::ArrayList<SleepEntry> sleepList;
-    Thread *currentThread = nullptr;
+    PerCpu<Thread*> currentThread;
+    Device::ApicTimer *highResolutionTimer = nullptr;
 
     static bool fpuAvailable;
 };
@@ -20,12 +20,13 @@
 #include "lib/util/async/Thread.h"
 #include "kernel/process/Process.h"
 #include "kernel/process/Thread.h"
+#include "kernel/process/ReadCopyUpdate.h"
 #include "lib/util/base/Exception.h"
 #include "lib/util/time/Timestamp.h"
 
 namespace Kernel {
 
-SchedulerCleaner::SchedulerCleaner() : processQueue(16), threadQueue(16) {}
+SchedulerCleaner::SchedulerCleaner() : processQueue(PROCESS_QUEUE_SIZE), threadQueue(16) {}
 
 SchedulerCleaner::~SchedulerCleaner() {
     SchedulerCleaner::run();
@@ -47,13 +48,20 @@ void SchedulerCleaner::run() {
     while (true) {
         cleanupThreads();
         cleanupProcesses();
-        Util::Async::Thread::sleep(Util::Time::Timestamp(1, 0));
+        ReadCopyUpdate::reclaim();
+        Util::Async::Thread::sleep(Util::Time::Timestamp::ofMilliseconds(CLEANUP_INTERVAL));
     }
 }
 
 void SchedulerCleaner::cleanupProcesses() {
-    while (processQueue.size() > 0) {
-        delete processQueue.poll();
+    // Deleting a process tears down its address space, so processes with remaining threads are kept for the next round
+    for (uint32_t count = processQueue.size(); count > 0; count--) {
+        auto *process = processQueue.poll();
+        if (process->getThreadCount() > 0) {
+            processQueue.offer(process);
+        } else {
+            delete process;
+        }
     }
 }
 
@@ -62,6 +62,9 @@ private:
 
     Util::ArrayBlockingQueue<Process*> processQueue;
     Util::ArrayBlockingQueue<Thread*> threadQueue;
+
+    static const constexpr uint32_t PROCESS_QUEUE_SIZE = 64;
+    static const constexpr uint32_t CLEANUP_INTERVAL = 100;
 };
 
 }
@@ -23,8 +23,10 @@
 #include "asm_interface.h"
 #include "Thread.h"
 #include "kernel/process/ThreadState.h"
+#include "kernel/process/Process.h"
 #include "kernel/service/MemoryService.h"
 #include "kernel/service/SchedulerService.h"
+#include "lib/util/async/Atomic.h"
 #include "lib/util/async/IdGenerator.h"
 #include "lib/util/async/Runnable.h"
 #include "lib/util/base/Constants.h"
@@ -62,7 +64,7 @@ Thread& Thread::createKernelThread(const Util::String &name, Process &parent, Ut
     thread->kernelContext->eip = reinterpret_cast<uint32_t>(interrupt_return);
 
     thread->interruptFrame.cs = 0x08;
-    thread->interruptFrame.fs = 0x10;
+    thread->interruptFrame.fs = 0x30; // Per-core data segment (see Processor)
     thread->interruptFrame.gs = 0x10;
     thread->interruptFrame.ds = 0x10;
     thread->interruptFrame.es = 0x10;
@@ -78,7 +80,7 @@ Thread& Thread::createKernelThread(const Util::String &name, Process &parent, Ut
 
 Thread& Thread::createUserThread(const Util::String &name, Process &parent, uint32_t eip, Util::Async::Runnable *runnable) {
     auto *kernelStack = Stack::createKernelStack(DEFAULT_STACK_SIZE);
-    auto *userStack = Stack::createUserStack(DEFAULT_STACK_SIZE);
+    auto *userStack = Stack::createUserStack(parent);
     auto *thread = new Thread(name, parent, nullptr, kernelStack, userStack);
 
     thread->kernelContext->eip = reinterpret_cast<uint32_t>(interrupt_return);
@@ -100,7 +102,7 @@ Thread& Thread::createUserThread(const Util::String &name, Process &parent, uint
     return *thread;
 }
 
-Thread& Thread::createMainUserThread(const Util::String &name, Process &parent, uint32_t eip, uint32_t argc, char **argv, void *envp, uint32_t heapStartAddress) {
+Thread& Thread::createMainUserThread(const Util::String &name, Process &parent, uint32_t eip, uint32_t argc, char **argv, void *envp, uint32_t heapStartAddress, uint32_t *libraryInitializers) {
     auto *kernelStack = Stack::createKernelStack(DEFAULT_STACK_SIZE);
     auto *userStack = Stack::createMainUserStack();
     auto *thread = new Thread(name, parent, nullptr, kernelStack, userStack);
@@ -118,6 +120,7 @@ Thread& Thread::createMainUserThread(const Util::String &name, Process &parent,
     thread->interruptFrame.ebx = reinterpret_cast<uint32_t>(argv);
     thread->interruptFrame.ecx = reinterpret_cast<uint32_t>(envp);
     thread->interruptFrame.edx = heapStartAddress;
+    thread->interruptFrame.esi = reinterpret_cast<uint32_t>(libraryInitializers);
     thread->interruptFrame.ebp = reinterpret_cast<uint32_t>(userStack->getStart());
     thread->interruptFrame.uesp = reinterpret_cast<uint32_t>(userStack->getStart());
     thread->interruptFrame.eflags = 0x200;
@@ -142,6 +145,14 @@ void Thread::run() {
     runnable->run();
 }
 
+void Thread::beginLockWait() {
+    Util::Async::Atomic<uint32_t>(lockWaits).inc();
+}
+
+void Thread::endLockWait() {
+    Util::Async::Atomic<uint32_t>(lockWaits).dec();
+}
+
 Process& Thread::getParent() const {
     return parent;
 }
@@ -167,7 +178,24 @@ void Thread::unblockJoinList() {
     joinLock.release();
 }
 
-Thread::Stack::Stack(uint8_t *stack, uint32_t size) : stack(stack), size(size) {
+void Thread::releaseUserStack() {
+    auto stackAddress = reinterpret_cast<uint32_t>(userStack->getEnd());
+    if (userStack == kernelStack || stackAddress < Util::USER_SPACE_STACK_AREA_START || stackAddress >= Util::MAIN_USER_STACK_ADDRESS) {
+        return;
+    }
+
+    // Only the pages, that have actually been touched, are mapped
+    auto &memoryService = System::getService<MemoryService>();
+    memoryService.unmap(stackAddress, reinterpret_cast<uint32_t>(userStack->getStart()) - 1, 0);
+    parent.freeUserStackSlot((stackAddress - Util::USER_SPACE_STACK_AREA_START) / Util::USER_STACK_SIZE);
+}
+
+Thread::Stack::Stack(uint8_t *stack, uint32_t size, bool initialize) : stack(stack), size(size) {
+    // User stacks are committed on demand and must not be touched here
+    if (!initialize) {
+        return;
+    }
+
     Util::Address<uint32_t>(stack).setRange(0, size);
 
     this->stack[0] = 0x44; // D
@@ -184,18 +212,25 @@ uint8_t* Thread::Stack::getStart() const {
     return &stack[size];
 }
 
+uint8_t* Thread::Stack::getEnd() const {
+    return stack;
+}
+
 Thread::Stack* Thread::Stack::createKernelStack(uint32_t size) {
     auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
-    return new Stack(static_cast<uint8_t*>(memoryService.allocateKernelMemory(size, 16)), size);
+    return new Stack(static_cast<uint8_t*>(memoryService.allocateKernelMemory(size, 16)), size, true);
 }
 
-Thread::Stack* Thread::Stack::createUserStack(uint32_t size) {
-    auto &memoryService = Kernel::System::getService<Kernel::MemoryService>();
-    return new Stack(static_cast<uint8_t*>(memoryService.allocateUserMemory(size, 16)), size);
+Thread::Stack* Thread::Stack::createUserStack(Process &parent) {
+    // The lowest page of the slot is left unmapped as guard page
+    uint32_t slot = parent.allocateUserStackSlot();
+    auto *stack = reinterpret_cast<uint8_t*>(Util::USER_SPACE_STACK_AREA_START + slot * Util::USER_STACK_SIZE + Paging::PAGESIZE);
+    return new Stack(stack, Util::USER_STACK_SIZE - Paging::PAGESIZE, false);
 }
 
 Thread::Stack* Thread::Stack::createMainUserStack() {
-    return new (reinterpret_cast<void*>(Util::USER_SPACE_STACK_INSTANCE_ADDRESS)) Stack(reinterpret_cast<uint8_t*>(MemoryLayout::KERNEL_START - Paging::PAGESIZE), Paging::PAGESIZE - 16);
+    auto *stack = reinterpret_cast<uint8_t*>(Util::MAIN_USER_STACK_ADDRESS + Paging::PAGESIZE);
+    return new (reinterpret_cast<void*>(Util::USER_SPACE_STACK_INSTANCE_ADDRESS)) Stack(stack, Util::MAIN_USER_STACK_SIZE - Paging::PAGESIZE - 16, false);
 }
 
 }
\ No newline at end of file
@@ -56,15 +56,21 @@ public:
 
         static Stack* createKernelStack(uint32_t size);
 
-        static Stack* createUserStack(uint32_t size);
+        /**
+         * Reserve a stack in the user stack area of the given process.
+         * The stack is not backed by memory, until it is touched (see MemoryService::trigger()).
+         */
+        static Stack* createUserStack(Process &parent);
 
         static Stack* createMainUserStack();
 
         [[nodiscard]] uint8_t* getStart() const;
 
+        [[nodiscard]] uint8_t* getEnd() const;
+
     private:
 
-        explicit Stack(uint8_t *stack, uint32_t size);
+        Stack(uint8_t *stack, uint32_t size, bool initialize);
 
         uint8_t *stack;
         uint32_t size;
@@ -91,7 +97,13 @@ public:
     static Thread &createUserThread(const Util::String &name, Process &parent, uint32_t eip,
                                     Util::Async::Runnable *runnable);
 
-    static Thread& createMainUserThread(const Util::String &name, Process &parent, uint32_t eip, uint32_t argc, char **argv, void *envp, uint32_t heapStartAddress);
+    /**
+     * Create the main thread of a user process. The arguments are passed to the program's entry point (see crt0.asm).
+     *
+     * @param libraryInitializers Null-terminated list of initialization functions of shared libraries,
+     *                            which are called before the program's own constructors (may be nullptr)
+     */
+    static Thread& createMainUserThread(const Util::String &name, Process &parent, uint32_t eip, uint32_t argc, char **argv, void *envp, uint32_t heapStartAddress, uint32_t *libraryInitializers);
 
     [[nodiscard]] uint32_t getId() const;
 
@@ -107,6 +119,20 @@ public:
 
     void unblockJoinList();
 
+    /**
+     * Unmap the committed pages of this thread's user stack and release its slot.
+     * Must be called by the exiting thread itself. The main thread's stack is released together with the address space.
+     */
+    void releaseUserStack();
+
+    /**
+     * Called by this thread, before it queues up in a fair lock (see Util::Async::Thread::beginLockWait()).
+     * While it is queued, Scheduler::kill() only marks it and the scheduler kills it, once it has left the queue.
+     */
+    void beginLockWait();
+
+    void endLockWait();
+
     virtual void run();
 
 private:
@@ -128,6 +154,9 @@ private:
     Util::ArrayList<Thread*> joinList;
     Util::Async::Spinlock joinLock;
 
+    uint32_t lockWaits = 0; // Number of fair locks, this thread is queued in (more than one, if interrupted while waiting)
+    bool killPending = false;
+
     static Util::Async::IdGenerator<uint32_t> idGenerator;
     static const constexpr uint32_t DEFAULT_STACK_SIZE = 4096;
 };
@@ -31,6 +31,7 @@ start_first_thread:
 
     mov dword [scheduler_initialized], 0x1
     call flush_tss
+    call load_per_cpu_segment
     call release_scheduler_lock
 
     ; start thread
@@ -57,6 +58,8 @@ switch_context:
     pop ebx
     pop ebp
 
+    ; The thread may have run on another core before -> Reload the segment base of this core
+    call load_per_cpu_segment
     call release_scheduler_lock
 
     ; resume next thread
@@ -65,4 +68,10 @@ switch_context:
 flush_tss:
     mov ax, 0x28
     ltr ax
+    ret
+
+; Load the per-core data segment into FS (see Processor.h)
+load_per_cpu_segment:
+    mov ax, 0x30
+    mov fs, ax
     ret
\ No newline at end of file
@@ -56,6 +56,10 @@ FilesystemService::FilesystemService() {
         return filesystemService.unmount(path);
     });
 
+    SystemCall::registerSystemCall(Util::System::SYNC, [](uint32_t, va_list) -> bool {
+        return System::getService<FilesystemService>().sync();
+    });
+
     SystemCall::registerSystemCall(Util::System::OPEN_FILE, [](uint32_t paramCount, va_list arguments) -> bool {
         if (paramCount < 2) {
             return false;
@@ -116,7 +120,7 @@ FilesystemService::FilesystemService() {
         auto fileDescriptor = va_arg(arguments, int32_t);
         auto &type = *va_arg(arguments, Util::Io::File::Type*);
 
-        type = System::getService<FilesystemService>().getNode(fileDescriptor).getType();
+        type = System::getService<FilesystemService>().getFileType(fileDescriptor);
         return true;
     });
 
@@ -170,6 +174,7 @@ FilesystemService::FilesystemService() {
         auto length = va_arg(arguments, uint64_t);
         auto &written = *va_arg(arguments, uint64_t*);
 
+        System::getService<MemoryService>().touchUserMemory(sourceBuffer, length);
         written = filesystemService.getNode(fileDescriptor).writeData(sourceBuffer, pos, length);
         return true;
     });
@@ -186,7 +191,8 @@ FilesystemService::FilesystemService() {
         auto length = va_arg(arguments, uint64_t);
         auto &read = *va_arg(arguments, uint64_t*);
 
-        read = filesystemService.getNode(fileDescriptor).readData(targetBuffer, pos, length);
+        System::getService<MemoryService>().touchUserMemory(targetBuffer, length);
+        read = filesystemService.readFile(fileDescriptor, targetBuffer, pos, length);
         return true;
     });
 
@@ -203,6 +209,17 @@ FilesystemService::FilesystemService() {
         return filesystemService.getNode(fileDescriptor).control(request, parameters);
     });
 
+    SystemCall::registerSystemCall(Util::System::SYNC_FILE, [](uint32_t paramCount, va_list arguments) -> bool {
+        if (paramCount < 1) {
+            return false;
+        }
+
+        auto &filesystemService = System::getService<FilesystemService>();
+        auto fileDescriptor = va_arg(arguments, int32_t);
+
+        return filesystemService.syncFile(fileDescriptor);
+    });
+
     SystemCall::registerSystemCall(Util::System::CHANGE_DIRECTORY, [](uint32_t paramCount, va_list arguments) -> bool {
         if (paramCount < 1) {
             return false;
@@ -241,6 +258,10 @@ bool FilesystemService::unmount(const Util::String &path) {
     return filesystem.unmount(path);
 }
 
+bool FilesystemService::sync() {
+    return filesystem.sync();
+}
+
 bool FilesystemService::createFilesystem(const Util::String &deviceName, const Util::String &driverName) {
     return filesystem.createFilesystem(deviceName, driverName);
 }
@@ -273,6 +294,18 @@ Filesystem::Node& FilesystemService::getNode(int32_t fileDescriptor) {
     return System::getService<ProcessService>().getCurrentProcess().getFileDescriptorManager().getNode(fileDescriptor);
 }
 
+Util::Io::File::Type FilesystemService::getFileType(int32_t fileDescriptor) {
+    return System::getService<ProcessService>().getCurrentProcess().getFileDescriptorManager().getType(fileDescriptor);
+}
+
+uint64_t FilesystemService::readFile(int32_t fileDescriptor, uint8_t *targetBuffer, uint64_t pos, uint64_t length) {
+    return System::getService<ProcessService>().getCurrentProcess().getFileDescriptorManager().readFile(fileDescriptor, targetBuffer, pos, length);
+}
+
+bool FilesystemService::syncFile(int32_t fileDescriptor) {
+    return getNode(fileDescriptor).sync();
+}
+
 Filesystem::Filesystem& FilesystemService::getFilesystem() {
     return filesystem;
 }
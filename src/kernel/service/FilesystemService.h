@@ -58,6 +58,8 @@ public:
 
     bool unmount(const Util::String &path);
 
+    bool sync();
+
     bool createFilesystem(const Util::String &deviceName, const Util::String &driverName);
 
     bool createFile(const Util::String &path);
@@ -74,6 +76,12 @@ public:
 
     Filesystem::Node& getNode(int32_t fileDescriptor);
 
+    [[nodiscard]] Util::Io::File::Type getFileType(int32_t fileDescriptor);
+
+    uint64_t readFile(int32_t fileDescriptor, uint8_t *targetBuffer, uint64_t pos, uint64_t length);
+
+    bool syncFile(int32_t fileDescriptor);
+
     [[nodiscard]] Filesystem::Filesystem& getFilesystem();
 
     [[nodiscard]] Util::Array<Filesystem::MountInformation> getMountInformation();
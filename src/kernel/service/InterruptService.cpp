@@ -65,6 +65,64 @@ void InterruptService::forbidHardwareInterrupt(Device::InterruptRequest interrup
     }
 }
 
+bool InterruptService::setHardwareInterruptAffinity(Device::InterruptRequest interrupt, uint32_t cpuMask) {
+    if (usesApic()) {
+        return apic->setAffinity(interrupt, cpuMask);
+    }
+
+    return cpuMask == 0x01;
+}
+
+uint32_t InterruptService::getHardwareInterruptAffinity(Device::InterruptRequest interrupt) {
+    return usesApic() ? apic->getAffinity(interrupt) : 0x01;
+}
+
+bool InterruptService::supportsMessageSignaledInterrupts() const {
+    return usesApic();
+}
+
+InterruptVector InterruptService::allocateMessageSignaledInterrupts(uint8_t count) {
+    if (!supportsMessageSignaledInterrupts() || count == 0) {
+        return static_cast<InterruptVector>(0);
+    }
+
+    uint32_t blockSize = 1;
+    while (blockSize < count) {
+        blockSize *= 2;
+    }
+
+    const uint32_t vectorCount = InterruptVector::MESSAGE_SIGNALED_END - InterruptVector::MESSAGE_SIGNALED_START + 1;
+    if (blockSize > vectorCount) {
+        return static_cast<InterruptVector>(0);
+    }
+
+    uint32_t blockMask = blockSize == 32 ? 0xffffffff : (1 << blockSize) - 1;
+
+    messageSignaledLock.acquire();
+    for (uint32_t i = 0; i < vectorCount; i += blockSize) {
+        if ((messageSignaledBitmap & (blockMask << i)) == 0) {
+            messageSignaledBitmap |= blockMask << i;
+            messageSignaledLock.release();
+
+            return static_cast<InterruptVector>(InterruptVector::MESSAGE_SIGNALED_START + i);
+        }
+    }
+
+    messageSignaledLock.release();
+    return static_cast<InterruptVector>(0);
+}
+
+void InterruptService::freeMessageSignaledInterrupts(InterruptVector first, uint8_t count) {
+    messageSignaledLock.acquire();
+    for (uint32_t i = 0; i < count; i++) {
+        auto vector = first + i;
+        if (vector >= InterruptVector::MESSAGE_SIGNALED_START && vector <= InterruptVector::MESSAGE_SIGNALED_END) {
+            messageSignaledBitmap &= ~(1 << (vector - InterruptVector::MESSAGE_SIGNALED_START));
+        }
+    }
+    messageSignaledLock.release();
+}
+
 void InterruptService::sendEndOfInterrupt(InterruptVector interrupt) {
     if (usesApic()) {
         apic->sendEndOfInterrupt(interrupt);
@@ -78,6 +136,18 @@ void InterruptService::startGdbServer(Device::SerialPort::ComPort port) {
     gdbServer.start(port);
 }
 
+InterruptDispatcher::Statistics InterruptService::getInterruptStatistics(InterruptVector slot) const {
+    return dispatcher.getStatistics(slot);
+}
+
+bool InterruptService::isMeasuringInterruptDurations() const {
+    return dispatcher.isMeasuringDurations();
+}
+
+void InterruptService::resetInterruptStatistics() {
+    dispatcher.resetStatistics();
+}
+
 bool InterruptService::checkSpuriousInterrupt(InterruptVector interrupt) {
     if (usesApic()) {
         return interrupt == InterruptVector::SPURIOUS;
@@ -25,6 +25,7 @@
 #include "kernel/service/Service.h"
 #include "device/debug/GdbServer.h"
 #include "device/port/serial/SerialPort.h"
+#include "lib/util/async/Spinlock.h"
 
 namespace Device {
 class Apic;
@@ -74,6 +75,34 @@ public:
 
     bool status(Device::InterruptRequest interrupt);
 
+    /**
+     * Set the cores, which may receive a hardware interrupt.
+     * Without an APIC, all interrupts are handled by the bootstrap processor and only a mask of 0x01 is accepted.
+     *
+     * @param interrupt The interrupt
+     * @param cpuMask A bitmask, containing one bit per CPU id
+     * @return true, if the affinity has been changed
+     */
+    bool setHardwareInterruptAffinity(Device::InterruptRequest interrupt, uint32_t cpuMask);
+
+    [[nodiscard]] uint32_t getHardwareInterruptAffinity(Device::InterruptRequest interrupt);
+
+    /**
+     * Message signaled interrupts are delivered directly to a local APIC, so they are only available in APIC mode.
+     */
+    [[nodiscard]] bool supportsMessageSignaledInterrupts() const;
+
+    /**
+     * Allocate a block of free interrupt vectors for MSI/MSI-X.
+     * The block is aligned to its size, as required by multi message MSI.
+     *
+     * @param count The number of vectors (rounded up to a power of two)
+     * @return The first vector of the block, or 0 if no block of the requested size is available
+     */
+    InterruptVector allocateMessageSignaledInterrupts(uint8_t count);
+
+    void freeMessageSignaledInterrupts(InterruptVector first, uint8_t count);
+
     uint16_t getInterruptMask();
 
     void setInterruptMask(uint16_t mask);
@@ -82,6 +111,12 @@ public:
 
     void startGdbServer(Device::SerialPort::ComPort port);
 
+    [[nodiscard]] InterruptDispatcher::Statistics getInterruptStatistics(InterruptVector slot) const;
+
+    [[nodiscard]] bool isMeasuringInterruptDurations() const;
+
+    void resetInterruptStatistics();
+
     [[nodiscard]] bool checkSpuriousInterrupt(InterruptVector interrupt);
 
     [[nodiscard]] Device::Apic& getApic();
@@ -104,6 +139,9 @@ private:
 
     bool parallelComputingAllowed = false;
 
+    Util::Async::Spinlock messageSignaledLock;
+    uint32_t messageSignaledBitmap = 0;
+
     static Kernel::Logger log;
 };
 
@@ -31,6 +31,10 @@
 #include "kernel/process/ThreadState.h"
 #include "kernel/system/SystemCall.h"
 #include "lib/util/base/Exception.h"
+#include "lib/util/base/Constants.h"
+#include "kernel/service/ProcessService.h"
+#include "kernel/process/Process.h"
+#include "kernel/process/ExecutableImage.h"
 #include "lib/util/base/HeapMemoryManager.h"
 #include "lib/util/base/System.h"
 #include "kernel/interrupt/InterruptVector.h"
@@ -136,6 +140,10 @@ void MemoryService::freePageTable(void *virtualTableAddress) {
     pagingAreaManager.freeBlock(virtualTableAddress);
 }
 
+void MemoryService::freePageFrames(const uint32_t *physicalAddresses, uint32_t count) {
+    pageFrameAllocator.freeBlocks(physicalAddresses, count);
+}
+
 void MemoryService::createPageTable(PageDirectory *directory, uint32_t index) {
     // Get some virtual memory for the table
     void *virtAddress = pagingAreaManager.allocateBlock();
@@ -176,6 +184,19 @@ void Kernel::MemoryService::map(uint32_t virtualAddress, uint16_t flags, bool in
     currentAddressSpace->getPageDirectory().map(physicalAddress, virtualAddress, flags, interrupt);
 }
 
+void Kernel::MemoryService::touchUserMemory(const void *address, uint64_t length) {
+    auto startAddress = reinterpret_cast<uint32_t>(address);
+    if (length == 0 || startAddress >= Kernel::MemoryLayout::KERNEL_START) {
+        return;
+    }
+
+    uint32_t endAddress = length < Kernel::MemoryLayout::KERNEL_START - startAddress ? startAddress + static_cast<uint32_t>(length) : Kernel::MemoryLayout::KERNEL_START;
+    for (uint32_t i = startAddress & 0xFFFFF000; i < endAddress; i += Kernel::Paging::PAGESIZE) {
+        // Reading a single byte is enough to let the page fault handler map (and possibly load) the page
+        static_cast<void>(*reinterpret_cast<volatile uint8_t*>(i < startAddress ? startAddress : i));
+    }
+}
+
 uint32_t Kernel::MemoryService::unmap(uint32_t virtualAddress) {
     uint32_t physAddress = currentAddressSpace->getPageDirectory().unmap(virtualAddress);
     if (!physAddress) {
@@ -360,11 +381,62 @@ void MemoryService::trigger(const Kernel::InterruptFrame &frame) {
         Util::Exception::throwException(Util::Exception::ILLEGAL_PAGE_ACCESS, "Privilege level not sufficient to access page!");
     }
 
+    // User stacks are committed on demand, but the lowest page of each stack is a guard page, which must never be mapped
+    if (faultAddress >= Util::USER_SPACE_STACK_AREA_START && faultAddress <= Util::USER_SPACE_STACK_AREA_END) {
+        uint32_t stackOffset = faultAddress >= Util::MAIN_USER_STACK_ADDRESS ? faultAddress - Util::MAIN_USER_STACK_ADDRESS : (faultAddress - Util::USER_SPACE_STACK_AREA_START) % Util::USER_STACK_SIZE;
+        if (stackOffset < Paging::PAGESIZE) {
+            Util::Exception::throwException(Util::Exception::ILLEGAL_PAGE_ACCESS, "Stack overflow!");
+        }
+    }
+
+    // Segments of the current executable and its libraries are read from their files, when they are accessed for the first time
+    if (faultAddress < Kernel::MemoryLayout::KERNEL_START && System::isServiceRegistered(ProcessService::SERVICE_ID)) {
+        auto *executable = System::getService<ProcessService>().getCurrentProcess().getExecutableImage(faultAddress);
+        if (executable != nullptr) {
+            loadExecutablePage(*executable, faultAddress & 0xFFFFF000);
+            return;
+        }
+    }
+
     // Map the faulted Page
     map(faultAddress, Paging::PRESENT | Paging::READ_WRITE | (faultAddress < Kernel::MemoryLayout::KERNEL_START ? Paging::USER_ACCESS : 0), true);
     // TODO: Check other Faults
 }
 
+void MemoryService::loadExecutablePage(ExecutableImage &executable, uint32_t pageAddress) {
+    bool shareable = executable.isShareable(pageAddress);
+
+    // Read-only pages, which have already been loaded by another process, are just mapped
+    if (shareable) {
+        uint32_t sharedFrame = executable.getSharedFrame(pageAddress);
+        if (sharedFrame != 0) {
+            mapPhysicalAddress(pageAddress, sharedFrame, Paging::PRESENT | Paging::USER_ACCESS);
+            return;
+        }
+    }
+
+    map(pageAddress, Paging::PRESENT | Paging::READ_WRITE | Paging::USER_ACCESS, true);
+
+    // Mapping is aborted, if the page table is locked by someone else -> The fault will occur again
+    auto *physicalAddress = getPhysicalAddress(reinterpret_cast<void*>(pageAddress));
+    if (physicalAddress == nullptr) {
+        return;
+    }
+
+    executable.loadPage(pageAddress);
+
+    if (shareable) {
+        // Write protect the page and offer it to other processes. The image holds its own reference on the frame.
+        currentAddressSpace->getPageDirectory().unsetPageFlags(pageAddress, Paging::READ_WRITE);
+        asm volatile("invlpg (%0)" : : "r"(pageAddress) : "memory");
+
+        auto *sharedFrame = pageFrameAllocator.allocateBlockAtAddress(physicalAddress);
+        if (!executable.publishSharedFrame(pageAddress, reinterpret_cast<uint32_t>(sharedFrame))) {
+            pageFrameAllocator.freeBlock(sharedFrame);
+        }
+    }
+}
+
 MemoryService::MemoryStatus MemoryService::getMemoryStatus() {
     return {pageFrameAllocator.getTotalMemory(), pageFrameAllocator.getFreeMemory(),
             lowerMemoryManager.getTotalMemory(), lowerMemoryManager.getFreeMemory(),
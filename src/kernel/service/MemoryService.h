@@ -30,6 +30,7 @@ namespace Kernel {
 class PageDirectory;
 class PageFrameAllocator;
 class PagingAreaManager;
+class ExecutableImage;
 struct InterruptFrame;
 }  // namespace Kernel
 
@@ -102,6 +103,15 @@ public:
      */
     void freePageTable(void *virtualTableAddress);
 
+    /**
+     * Return a batch of page frames to the page frame allocator.
+     * The frames must not be mapped in any active address space anymore, so no TLB entries are invalidated.
+     *
+     * @param physicalAddresses Physical addresses of the page frames
+     * @param count Amount of page frames
+     */
+    void freePageFrames(const uint32_t *physicalAddresses, uint32_t count);
+
     /**
      * Create Page Table for a non present entry in Page Directory.
      *
@@ -137,6 +147,16 @@ public:
      */
     void map(uint32_t virtualAddress, uint16_t flags, bool interrupt = false);
 
+    /**
+     * Touch every page of a user buffer, before it is handed to a filesystem driver.
+     * Pages of the current executable are loaded from its file on the first access (see ExecutableImage),
+     * which must not happen from a page fault inside the driver, since it would enter the driver again.
+     *
+     * @param address Start address of the buffer
+     * @param length Length of the buffer in bytes
+     */
+    void touchUserMemory(const void *address, uint64_t length);
+
     /**
      * Map a physical address into the current address space's heap.
      * This is usually used to map physical TransferMode memory (e.g. for the LFB) into a virtual address space and be able to access it.
@@ -233,6 +253,11 @@ public:
 
 private:
 
+    /**
+     * Map and fill a page belonging to the current process' executable (see ExecutableImage).
+     */
+    void loadExecutablePage(ExecutableImage &executable, uint32_t pageAddress);
+
     Util::FreeListMemoryManager lowerMemoryManager;
 
     PageFrameAllocator &pageFrameAllocator;
@@ -22,6 +22,7 @@
 #include "kernel/system/SystemCall.h"
 #include "lib/util/hardware/Machine.h"
 #include "kernel/system/System.h"
+#include "kernel/service/FilesystemService.h"
 #include "device/power/Machine.h"
 #include "lib/util/base/System.h"
 
@@ -52,10 +53,13 @@ PowerManagementService::~PowerManagementService() {
 }
 
 void PowerManagementService::shutdownMachine() {
+    // File data may still be cached by filesystem drivers
+    System::getService<FilesystemService>().sync();
     machine.shutdown();
 }
 
 void PowerManagementService::rebootMachine() {
+    System::getService<FilesystemService>().sync();
     machine.reboot();
 }
 
@@ -17,7 +17,6 @@
 
 #include <stdarg.h>
 
-#include "kernel/process/AddressSpaceCleaner.h"
 #include "kernel/system/System.h"
 #include "kernel/process/BinaryLoader.h"
 #include "ProcessService.h"
@@ -25,6 +24,8 @@
 #include "kernel/file/FileDescriptorManager.h"
 #include "kernel/process/Process.h"
 #include "kernel/process/Thread.h"
+#include "kernel/process/ExecutableImage.h"
+#include "filesystem/core/Filesystem.h"
 #include "kernel/service/MemoryService.h"
 #include "kernel/service/SchedulerService.h"
 #include "kernel/system/SystemCall.h"
@@ -151,13 +152,14 @@ void ProcessService::killProcess(Process &process) {
     }
     schedulerService.unlockScheduler();
 
-    auto &cleanerThread = Thread::createKernelThread("Address-Space-Cleaner", process, new AddressSpaceCleaner());
-    schedulerService.ready(cleanerThread);
     process.setExitCode(-1);
 
     lock.acquire();
     processList.remove(&process);
     lock.release();
+
+    // The address space is torn down in the background by the scheduler cleaner
+    schedulerService.cleanup(&process);
 }
 
 Process& ProcessService::getCurrentProcess() {
@@ -177,17 +179,17 @@ bool ProcessService::isProcessActive(uint32_t id) {
 void ProcessService::exitCurrentProcess(int32_t exitCode) {
     auto &schedulerService = System::getService<SchedulerService>();
     auto &process = getCurrentProcess();
-    auto &cleanerThread = Thread::createKernelThread("Address-Space-Cleaner", process, new AddressSpaceCleaner());
 
     process.killAllThreadsButCurrent();
-    schedulerService.ready(cleanerThread);
-
     process.setExitCode(exitCode);
 
     lock.acquire();
     processList.remove(&process);
     lock.release();
 
+    // The address space is torn down in the background by the scheduler cleaner, after this thread has exited
+    schedulerService.cleanup(&process);
+
     schedulerService.exitCurrentThread();
 
     __builtin_unreachable();
@@ -216,4 +218,46 @@ Util::Array<uint32_t> ProcessService::getActiveProcessIds() const {
     return ids;
 }
 
+ExecutableImage& ProcessService::acquireExecutableImage(const Util::String &path, uint32_t loadAddress) {
+    auto *node = System::getService<FilesystemService>().getFilesystem().getNode(path);
+    if (node == nullptr) {
+        Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "ProcessService: Executable not found!");
+    }
+
+    // Reading the program headers is cheap, compared to loading the executable, and tells us whether the file has changed
+    auto *image = new ExecutableImage(path, node, loadAddress);
+
+    executableImageLock.acquire();
+    for (uint32_t i = 0; i < executableImages.size(); i++) {
+        auto *cachedImage = executableImages.get(i);
+        if (cachedImage->isIdentical(*image)) {
+            cachedImage->acquire();
+            executableImages.removeIndex(i);
+            executableImages.add(cachedImage);
+            executableImageLock.release();
+
+            delete image;
+            return *cachedImage;
+        }
+    }
+
+    image->acquire();
+    executableImages.add(image);
+
+    // Evict the least recently used images, which are not used by any process
+    for (uint32_t i = 0; i < executableImages.size() && executableImages.size() > MAX_CACHED_EXECUTABLE_IMAGES;) {
+        auto *cachedImage = executableImages.get(i);
+        if (cachedImage->isReferenced()) {
+            i++;
+            continue;
+        }
+
+        executableImages.removeIndex(i);
+        delete cachedImage;
+    }
+
+    executableImageLock.release();
+    return *image;
+}
+
 }
\ No newline at end of file
@@ -35,6 +35,7 @@ class File;
 
 namespace Kernel {
 class VirtualAddressSpace;
+class ExecutableImage;
 
 class ProcessService : public Service {
 
@@ -77,13 +78,28 @@ public:
 
     [[nodiscard]] Util::Array<uint32_t> getActiveProcessIds() const;
 
+    /**
+     * Get the image of an executable file and acquire a reference on it.
+     * Images are cached, so that processes running the same executable share its read-only pages.
+     * The reference must be released, when the process using the image has terminated.
+     *
+     * @param loadAddress The address, at which a shared library is mapped (images are only shared at the same address)
+     */
+    [[nodiscard]] ExecutableImage& acquireExecutableImage(const Util::String &path, uint32_t loadAddress = 0);
+
     static const constexpr uint8_t SERVICE_ID = 7;
 
 private:
 
     Util::ArrayList<Process*> processList;
-    Util::Async::Spinlock lock;
+    Util::Async::Spinlock lock{"ProcessService"};
     Process &kernelProcess;
+
+    // Cached executable images, ordered from least to most recently used
+    Util::ArrayList<ExecutableImage*> executableImages;
+    Util::Async::Spinlock executableImageLock{"ProcessService::ExecutableImages"};
+
+    static const constexpr uint32_t MAX_CACHED_EXECUTABLE_IMAGES = 16;
 };
 
 }
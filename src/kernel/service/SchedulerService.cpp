@@ -197,6 +197,7 @@ void SchedulerService::killWithoutLock(Thread &thread) {
 }
 
 void SchedulerService::exitCurrentThread() {
+    scheduler.getCurrentThread().releaseUserStack();
     scheduler.exit();
 }
 
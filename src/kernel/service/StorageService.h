@@ -62,7 +62,7 @@ public:
 
 private:
 
-    Util::Async::ReentrantSpinlock lock;
+    Util::Async::ReentrantSpinlock lock{"StorageService"};
     Util::HashMap<Util::String, Device::Storage::StorageDevice*> deviceMap;
 
     static Logger log;
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "LockStatisticsNode.h"
+
+#include "lib/util/async/LockProfiler.h"
+
+namespace Kernel {
+
+LockStatisticsNode::LockStatisticsNode(const Util::String &name) : StringNode(name) {}
+
+Util::String LockStatisticsNode::getString() {
+    if (!Util::Async::LockProfiler::isEnabled()) {
+        return "Lock profiling is disabled (build with HHUOS_LOCK_PROFILING=ON)\n";
+    }
+
+    Util::String result;
+    for (uint32_t i = 0; i < Util::Async::LockProfiler::getLockCount(); i++) {
+        const auto &statistics = Util::Async::LockProfiler::getStatistics(i);
+        if (statistics.name == nullptr) {
+            continue;
+        }
+
+        result += Util::String::format("%s: Acquisitions [%u], Contended [%u], Spin iterations [%u], Max hold cycles [%u]\n",
+                                       statistics.name, statistics.acquisitions, statistics.contendedAcquisitions,
+                                       statistics.spinIterations, statistics.maxHoldCycles);
+    }
+
+    return result;
+}
+
+uint64_t LockStatisticsNode::writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) {
+    Util::Async::LockProfiler::reset();
+    return numBytes;
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_LOCKSTATISTICSNODE_H
+#define HHUOS_LOCKSTATISTICSNODE_H
+
+#include <cstdint>
+
+#include "filesystem/memory/StringNode.h"
+#include "lib/util/base/String.h"
+
+namespace Kernel {
+
+/**
+ * Shows the contention statistics of all named locks, collected by the LockProfiler.
+ * Writing anything to this node resets all statistics.
+ */
+class LockStatisticsNode : public Filesystem::Memory::StringNode {
+
+public:
+    /**
+     * Constructor.
+     */
+    explicit LockStatisticsNode(const Util::String &name);
+
+    /**
+     * Copy Constructor.
+     */
+    LockStatisticsNode(const LockStatisticsNode &copy) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    LockStatisticsNode& operator=(const LockStatisticsNode &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~LockStatisticsNode() override = default;
+
+    /**
+     * Overriding function from StringNode.
+     */
+    Util::String getString() override;
+
+    /**
+     * Overriding function from MemoryNode.
+     */
+    uint64_t writeData(const uint8_t *sourceBuffer, uint64_t pos, uint64_t numBytes) override;
+};
+
+}
+
+#endif
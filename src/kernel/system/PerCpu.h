@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_PERCPU_H
+#define HHUOS_PERCPU_H
+
+#include <cstdint>
+
+#include "kernel/system/Processor.h"
+
+namespace Kernel {
+
+/**
+ * Holds a separate instance of a variable for each processor core, indexed by Processor::getCurrentIndex().
+ * Each core only modifies its own instance, so no locks or atomic operations are needed,
+ * as long as the accessing thread cannot be migrated to another core in between (see Processor::getCurrentIndex()).
+ * Instances are padded to a full cache line, so that cores do not invalidate each other's cache lines.
+ */
+template<typename T>
+class PerCpu {
+
+public:
+    /**
+     * Default Constructor.
+     * All instances are value-initialized.
+     */
+    PerCpu() = default;
+
+    /**
+     * Constructor.
+     *
+     * @param initialValue The value, all instances are initialized with
+     */
+    explicit PerCpu(const T &initialValue);
+
+    /**
+     * Copy Constructor.
+     */
+    PerCpu(const PerCpu &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    PerCpu &operator=(const PerCpu &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~PerCpu() = default;
+
+    /**
+     * Get the instance of the current core.
+     */
+    [[nodiscard]] T& get();
+
+    /**
+     * Get the instance of a specific core (e.g. to sum up counters).
+     *
+     * @param processorIndex The core's index (see Processor)
+     */
+    [[nodiscard]] T& get(uint32_t processorIndex);
+
+    /**
+     * Get the instance of a specific core (e.g. to sum up counters).
+     *
+     * @param processorIndex The core's index (see Processor)
+     */
+    [[nodiscard]] const T& get(uint32_t processorIndex) const;
+
+    /**
+     * Set the instance of the current core.
+     */
+    void set(const T &value);
+
+private:
+
+    static const constexpr uint32_t CACHE_LINE_SIZE = 64;
+
+    struct Slot {
+        T value;
+        uint8_t padding[CACHE_LINE_SIZE - sizeof(T) % CACHE_LINE_SIZE];
+    };
+
+    Slot slots[Processor::MAX_PROCESSORS]{};
+};
+
+template<typename T>
+PerCpu<T>::PerCpu(const T &initialValue) {
+    for (auto &slot : slots) {
+        slot.value = initialValue;
+    }
+}
+
+template<typename T>
+T& PerCpu<T>::get() {
+    return slots[Processor::getCurrentIndex()].value;
+}
+
+template<typename T>
+T& PerCpu<T>::get(uint32_t processorIndex) {
+    return slots[processorIndex].value;
+}
+
+template<typename T>
+const T& PerCpu<T>::get(uint32_t processorIndex) const {
+    return slots[processorIndex].value;
+}
+
+template<typename T>
+void PerCpu<T>::set(const T &value) {
+    slots[Processor::getCurrentIndex()].value = value;
+}
+
+}
+
+#endif
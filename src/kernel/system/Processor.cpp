@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Processor.h"
+
+#include "device/cpu/Cpu.h"
+#include "kernel/system/System.h"
+#include "lib/util/async/Atomic.h"
+#include "lib/util/base/Exception.h"
+
+namespace Kernel {
+
+bool Processor::apicEnabled = false;
+uint32_t Processor::count = 1;
+Processor::LocalData Processor::localData[MAX_PROCESSORS]{};
+
+void Processor::createLocalDataDescriptor(uint16_t *gdt, uint32_t index) {
+    System::createGlobalDescriptorTableEntry(gdt, LOCAL_DATA_GDT_ENTRY, reinterpret_cast<uint32_t>(&localData[index]), sizeof(LocalData), 0x92, 0x4);
+}
+
+uint32_t Processor::registerCurrentProcessor() {
+    // The bootstrap processor keeps the index it has been using since boot
+    uint32_t index = 0;
+    if (apicEnabled) {
+        index = Util::Async::Atomic<uint32_t>(count).fetchAndInc();
+        if (index >= MAX_PROCESSORS) {
+            Util::Exception::throwException(Util::Exception::OUT_OF_BOUNDS, "Processor: Too many processors!");
+        }
+    }
+
+    localData[index].index = index;
+
+    // Point the data segment of this core's GDT to its own data and reload FS, so that the new segment base is used
+    Device::Cpu::Descriptor gdtDescriptor{};
+    asm volatile ("sgdt %0" : "=m"(gdtDescriptor));
+    createLocalDataDescriptor(reinterpret_cast<uint16_t*>(gdtDescriptor.address), index);
+    asm volatile ("mov %0, %%fs" : : "r"(LOCAL_DATA_SELECTOR));
+
+    apicEnabled = true;
+    return index;
+}
+
+uint32_t Processor::getCurrentIndex() {
+    if (!apicEnabled) {
+        return 0;
+    }
+
+    uint32_t index;
+    asm volatile ("mov %%fs:0, %0" : "=r"(index));
+    return index;
+}
+
+uint32_t Processor::getCount() {
+    return count;
+}
+
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_PROCESSOR_H
+#define HHUOS_PROCESSOR_H
+
+#include <cstdint>
+
+namespace Kernel {
+
+/**
+ * Assigns a dense index (0 to MAX_PROCESSORS - 1) to each processor core, which is used to address per-core data (see PerCpu).
+ * As long as the local APIC has not been initialized (or the system uses the PIC), only the bootstrap processor is running,
+ * which always has index 0.
+ * Each core's GDT contains a small data segment (LOCAL_DATA_SELECTOR), whose base points to the core's LocalData.
+ * The kernel keeps this segment loaded in FS (see interrupt.asm and thread.asm), so that the index can be read
+ * with a single memory access, instead of reading the local APIC id via MMIO.
+ */
+class Processor {
+
+public:
+
+    static const constexpr uint32_t MAX_PROCESSORS = 16;
+    static const constexpr uint16_t LOCAL_DATA_GDT_ENTRY = 6;
+    static const constexpr uint16_t LOCAL_DATA_SELECTOR = LOCAL_DATA_GDT_ENTRY * 8;
+
+    /**
+     * Default Constructor.
+     * Deleted, as this class has only static members.
+     */
+    Processor() = delete;
+
+    /**
+     * Copy Constructor.
+     */
+    Processor(const Processor &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    Processor &operator=(const Processor &other) = delete;
+
+    /**
+     * Destructor.
+     * Deleted, as this class has only static members.
+     */
+    ~Processor() = delete;
+
+    /**
+     * Create the per-core data segment descriptor in a GDT.
+     * Until registerCurrentProcessor() is called on the core owning the GDT, the segment points to the data of the bootstrap processor.
+     *
+     * @param gdt The GDT (needs space for at least LOCAL_DATA_GDT_ENTRY + 1 entries)
+     * @param index The index of the core, whose data the segment points to
+     */
+    static void createLocalDataDescriptor(uint16_t *gdt, uint32_t index);
+
+    /**
+     * Assign an index to the current core. Must be called once per core, right after its local APIC has been initialized.
+     * The bootstrap processor must be registered first, so that it keeps index 0.
+     *
+     * @return The index of the current core
+     */
+    static uint32_t registerCurrentProcessor();
+
+    /**
+     * Get the index of the core, this function is executed on.
+     * The result is only meaningful as long as the calling thread cannot be migrated to another core
+     * (e.g. inside an interrupt handler or while holding the scheduler lock).
+     */
+    static uint32_t getCurrentIndex();
+
+    /**
+     * Get the number of registered cores (at least 1).
+     */
+    static uint32_t getCount();
+
+private:
+
+    struct LocalData {
+        uint32_t index;
+    };
+
+    static bool apicEnabled;
+    static uint32_t count;
+    static LocalData localData[MAX_PROCESSORS];
+};
+
+}
+
+#endif
@@ -45,6 +45,7 @@
 #include "kernel/service/SchedulerService.h"
 #include "kernel/system/SystemCall.h"
 #include "kernel/system/TaskStateSegment.h"
+#include "kernel/system/Processor.h"
 #include "lib/util/async/Spinlock.h"
 #include "lib/util/collection/Array.h"
 #include "lib/util/base/FreeListMemoryManager.h"
@@ -57,7 +58,7 @@ namespace Kernel {
 class Service;
 
 bool System::initialized = false;
-Util::Async::Spinlock System::serviceLock;
+Util::Async::Spinlock System::serviceLock("System.services");
 Service* System::serviceMap[256]{};
 Util::HeapMemoryManager *System::kernelHeapMemoryManager{};
 InterruptHandler *System::pagefaultHandler{};
@@ -230,8 +231,8 @@ void System::panic(const InterruptFrame &frame) {
  * @param physicalGdtDescriptor Pointer to the descriptor of GDT; this descriptor should contain the physical address of GDT
  */
 void System::initializeGlobalDescriptorTables(uint16_t *systemGdt, uint16_t *biosGdt, uint16_t *systemGdtDescriptor, uint16_t *biosGdtDescriptor, uint16_t *physicalGdtDescriptor) {
-    // Set first 6 GDT entries to 0
-    Util::Address<uint32_t>(systemGdt).setRange(0, 48);
+    // Set first 7 GDT entries to 0
+    Util::Address<uint32_t>(systemGdt).setRange(0, 56);
 
     // Set first 4 bios GDT entries to 0
     Util::Address<uint32_t>(biosGdt).setRange(0, 32);
@@ -249,14 +250,16 @@ void System::initializeGlobalDescriptorTables(uint16_t *systemGdt, uint16_t *bio
     System::createGlobalDescriptorTableEntry(systemGdt, 4, 0, 0xFFFFFFFF, 0xF2, 0x0C);
     // tss segment
     System::createGlobalDescriptorTableEntry(systemGdt, 5, reinterpret_cast<uint32_t>(&System::taskStateSegment), sizeof(Kernel::TaskStateSegment), 0x89, 0x4);
+    // per-core data segment (see Processor)
+    Processor::createLocalDataDescriptor(systemGdt, 0);
 
     // set up descriptor for GDT
-    *((uint16_t *) systemGdtDescriptor) = 6 * 8;
+    *((uint16_t *) systemGdtDescriptor) = 7 * 8;
     // the normal descriptor should contain the virtual address of GDT
     *((uint32_t *) (systemGdtDescriptor + 1)) = (uint32_t) systemGdt + Kernel::MemoryLayout::KERNEL_START;
 
     // set up descriptor for GDT with phys. address - needed for bootstrapping
-    *((uint16_t *) physicalGdtDescriptor) = 6 * 8;
+    *((uint16_t *) physicalGdtDescriptor) = 7 * 8;
     // this descriptor should contain the physical address of GDT
     *((uint32_t *) (physicalGdtDescriptor + 1)) = (uint32_t) systemGdt;
 
@@ -26,13 +26,21 @@ _start:
     push ebx
     push eax
 
-    push 0xbfffefff        ; Push second parameter (endAddress) on the stack
+    push 0xafffffff        ; Push second parameter (endAddress) on the stack (heap ends below the shared library area)
     push edx               ; Push first parameter (startAddress) on the stack
     call initMemoryManager
     add esp,8
 
-    ; Initialize bss
+    ; Initialize bss (only for statically linked programs, indicated by esi being null).
+    ; The bss of a dynamically linked program may already contain data copied from shared libraries (R_386_COPY),
+    ; so it relies on the kernel zero-filling its pages.
+    test esi,esi
+    jnz _start_bss_done
     call clear_bss
+_start_bss_done:
+
+    ; Initialize static variables of shared libraries (esi points to a null-terminated list of functions)
+    call _init_libraries
 
     ; Initialize static variables
     call _init
@@ -64,6 +72,20 @@ clear_bss_loop:
 clear_bss_done:
     ret
 
+; Call initialization functions of shared libraries
+_init_libraries:
+    test esi,esi
+    jz _init_libraries_done
+_init_libraries_loop:
+    mov eax,[esi]
+    test eax,eax
+    jz _init_libraries_done
+    call eax
+    add esi,4
+    jmp _init_libraries_loop
+_init_libraries_done:
+    ret
+
 ; Call constructors of global objects
 _init:
     mov edi,___INIT_ARRAY_START__
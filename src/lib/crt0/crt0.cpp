@@ -2,7 +2,7 @@
 #include <cstdarg>
 #include "lib/util/base/operators.h"
 #include "lib/util/base/Constants.h"
-#include "lib/util/base/FreeListMemoryManager.h"
+#include "lib/util/base/SlabMemoryManager.h"
 
 // Export functions
 extern "C" {
@@ -11,7 +11,7 @@ void _exit(int32_t);
 }
 
 void initMemoryManager(uint8_t *startAddress, uint8_t *endAddress) {
-    auto *memoryManager = new (reinterpret_cast<void*>(Util::USER_SPACE_MEMORY_MANAGER_ADDRESS)) Util::FreeListMemoryManager();
+    auto *memoryManager = new (reinterpret_cast<void*>(Util::USER_SPACE_MEMORY_MANAGER_ADDRESS)) Util::SlabMemoryManager();
     memoryManager->initialize(startAddress, endAddress);
 }
 
@@ -51,6 +51,7 @@ void unmap(uint32_t virtualStartAddress, uint32_t virtualEndAddress, uint32_t br
 
 bool mount(const Util::String &deviceName, const Util::String &targetPath, const Util::String &driverName);
 bool unmount(const Util::String &path);
+bool syncFilesystem();
 bool createFile(const Util::String &path, Util::Io::File::Type type);
 bool deleteFile(const Util::String &path);
 int32_t openFile(const Util::String &path);
@@ -61,6 +62,7 @@ Util::Array<Util::String> getFileChildren(int32_t fileDescriptor);
 uint64_t readFile(int32_t fileDescriptor, uint8_t *targetBuffer, uint64_t pos, uint64_t length);
 uint64_t writeFile(int32_t fileDescriptor, const uint8_t *sourceBuffer, uint64_t pos, uint64_t length);
 bool controlFile(int32_t fileDescriptor, uint32_t request, const Util::Array<uint32_t> &parameters);
+bool syncFile(int32_t fileDescriptor);
 bool changeDirectory(const Util::String &path);
 Util::Io::File getCurrentWorkingDirectory();
 
@@ -77,6 +79,8 @@ void joinProcess(uint32_t id);
 void killProcess(uint32_t id);
 void sleep(const Util::Time::Timestamp &time);
 void yield();
+void beginLockWait();
+void endLockWait();
 
 Util::Time::Timestamp getSystemTime();
 Util::Time::Date getCurrentDate();
@@ -96,6 +96,10 @@ bool unmount(const Util::String &path) {
     return Kernel::System::getService<Kernel::FilesystemService>().unmount(path);
 }
 
+bool syncFilesystem() {
+    return Kernel::System::getService<Kernel::FilesystemService>().sync();
+}
+
 bool createFile(const Util::String &path, Util::Io::File::Type type) {
     auto &filesystemService = Kernel::System::getService<Kernel::FilesystemService>();
     if (type == Util::Io::File::REGULAR) {
@@ -120,7 +124,7 @@ void closeFile(int32_t fileDescriptor) {
 }
 
 Util::Io::File::Type getFileType(int32_t fileDescriptor) {
-    return Kernel::System::getService<Kernel::FilesystemService>().getNode(fileDescriptor).getType();
+    return Kernel::System::getService<Kernel::FilesystemService>().getFileType(fileDescriptor);
 }
 
 uint32_t getFileLength(int32_t fileDescriptor) {
@@ -132,7 +136,7 @@ Util::Array<Util::String> getFileChildren(int32_t fileDescriptor) {
 }
 
 uint64_t readFile(int32_t fileDescriptor, uint8_t *targetBuffer, uint64_t pos, uint64_t length) {
-    return Kernel::System::getService<Kernel::FilesystemService>().getNode(fileDescriptor).readData(targetBuffer, pos, length);
+    return Kernel::System::getService<Kernel::FilesystemService>().readFile(fileDescriptor, targetBuffer, pos, length);
 }
 
 uint64_t writeFile(int32_t fileDescriptor, const uint8_t *sourceBuffer, uint64_t pos, uint64_t length) {
@@ -143,6 +147,10 @@ bool controlFile(int32_t fileDescriptor, uint32_t request, const Util::Array<uin
     return Kernel::System::getService<Kernel::FilesystemService>().getNode(fileDescriptor).control(request, parameters);
 }
 
+bool syncFile(int32_t fileDescriptor) {
+    return Kernel::System::getService<Kernel::FilesystemService>().syncFile(fileDescriptor);
+}
+
 bool changeDirectory(const Util::String &path) {
     return Kernel::System::getService<Kernel::ProcessService>().getCurrentProcess().setWorkingDirectory(path);
 }
@@ -231,6 +239,18 @@ void yield() {
     Kernel::System::getService<Kernel::SchedulerService>().yield();
 }
 
+void beginLockWait() {
+    if (scheduler_initialized) {
+        Kernel::System::getService<Kernel::SchedulerService>().getCurrentThread().beginLockWait();
+    }
+}
+
+void endLockWait() {
+    if (scheduler_initialized) {
+        Kernel::System::getService<Kernel::SchedulerService>().getCurrentThread().endLockWait();
+    }
+}
+
 Util::Time::Timestamp getSystemTime() {
     return Kernel::System::getService<Kernel::TimeService>().getSystemTime();
 }
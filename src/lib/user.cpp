@@ -81,6 +81,10 @@ bool unmount(const Util::String &path) {
     return Util::System::call(Util::System::UNMOUNT, 1, static_cast<const char*>(path)) ;
 }
 
+bool syncFilesystem() {
+    return Util::System::call(Util::System::SYNC, 0);
+}
+
 bool createFile(const Util::String &path, Util::Io::File::Type type) {
     return Util::System::call(Util::System::CREATE_FILE, 2, static_cast<const char*>(path), type);
 }
@@ -142,6 +146,10 @@ bool controlFile(int32_t fileDescriptor, uint32_t request, const Util::Array<uin
     return Util::System::call(Util::System::CONTROL_FILE, 3, fileDescriptor, request, &parameters);
 }
 
+bool syncFile(int32_t fileDescriptor) {
+    return Util::System::call(Util::System::SYNC_FILE, 1, fileDescriptor);
+}
+
 bool changeDirectory(const Util::String &path) {
     return Util::System::call(Util::System::CHANGE_DIRECTORY, 1, static_cast<const char*>(path));
 }
@@ -216,6 +224,12 @@ void yield() {
     Util::System::call(Util::System::YIELD, 0);
 }
 
+void beginLockWait() {
+    // User threads are only killed together with their whole process, so nobody is left waiting for the lock
+}
+
+void endLockWait() {}
+
 Util::Time::Timestamp getSystemTime() {
     Util::Time::Timestamp systemTime;
     Util::System::call(Util::System::GET_SYSTEM_TIME, 1, &systemTime);
@@ -25,6 +25,25 @@ AtomicBitmap::AtomicBitmap(uint32_t blockCount) : blocks(blockCount) {
     arraySize = (blockCount % 32 == 0) ? (blockCount / 32) : (blockCount / 32 + 1);
     bitmap = new uint32_t[arraySize];
     Address<uint32_t>(bitmap).setRange(0, arraySize * sizeof(uint32_t));
+
+    // Bits behind the last valid block are always set, so that the last word can be recognized as full
+    if (blockCount % 32 != 0) {
+        bitmap[arraySize - 1] = ~getValidMask(arraySize - 1);
+    }
+
+    summarySize = (arraySize % 32 == 0) ? (arraySize / 32) : (arraySize / 32 + 1);
+    summary = new uint32_t[summarySize];
+    Address<uint32_t>(summary).setRange(0, summarySize * sizeof(uint32_t));
+
+    // Summary bits behind the last word are always set, so that they are never considered by findAndSet()
+    if (arraySize % 32 != 0) {
+        summary[summarySize - 1] = FULL_WORD << (arraySize % 32);
+    }
+}
+
+AtomicBitmap::~AtomicBitmap() {
+    delete[] bitmap;
+    delete[] summary;
 }
 
 uint32_t AtomicBitmap::getSize() const {
@@ -40,7 +59,8 @@ void AtomicBitmap::set(uint32_t block) {
     uint32_t bit = block % 32;
 
     Async::Atomic<uint32_t> bitmapWrapper(bitmap[index]);
-    bitmapWrapper.bitSet(31 - bit);
+    bitmapWrapper.bitSet(bit);
+    markIfFull(index);
 }
 
 void AtomicBitmap::unset(uint32_t block) {
@@ -52,7 +72,11 @@ void AtomicBitmap::unset(uint32_t block) {
     uint32_t bit = block % 32;
 
     Async::Atomic<uint32_t> bitmapWrapper(bitmap[index]);
-    bitmapWrapper.bitReset(31 - bit);
+    bitmapWrapper.bitReset(bit);
+
+    // The summary bit must be cleared after the block has been released, so that a concurrent findAndSet() can not miss it
+    Async::Atomic<uint32_t> summaryWrapper(summary[index / 32]);
+    summaryWrapper.bitReset(index % 32);
 }
 
 bool AtomicBitmap::check(uint32_t block, bool set) {
@@ -64,47 +88,90 @@ bool AtomicBitmap::check(uint32_t block, bool set) {
     uint32_t bit = block % 32;
 
     Async::Atomic<uint32_t> bitmapWrapper(bitmap[index]);
-    return bitmapWrapper.bitTest(31 - bit) == set;
+    return bitmapWrapper.bitTest(bit) == set;
 }
 
 uint32_t AtomicBitmap::findAndSet() {
-    uint32_t i;
-
-    for (i = 0; i < blocks; i++) {
-        uint32_t index = i / 32;
-        uint32_t bit = i % 32;
+    if (blocks == 0) {
+        return INVALID_INDEX;
+    }
 
-        Async::Atomic<uint32_t> bitmapWrapper(bitmap[index]);
-        if (!bitmapWrapper.bitTestAndSet(31 - bit)) {
-            break;
+    // Start at the summary word, containing the last successfully used word (next fit) and wrap around once
+    uint32_t startSummaryIndex = searchHint / 32;
+    for (uint32_t i = 0; i < summarySize; i++) {
+        uint32_t summaryIndex = startSummaryIndex + i < summarySize ? startSummaryIndex + i : startSummaryIndex + i - summarySize;
+        Async::Atomic<uint32_t> summaryWrapper(summary[summaryIndex]);
+
+        uint32_t candidates = ~summaryWrapper.get();
+        while (candidates != 0) {
+            uint32_t index = summaryIndex * 32 + __builtin_ctz(candidates);
+            candidates &= candidates - 1;
+
+            Async::Atomic<uint32_t> bitmapWrapper(bitmap[index]);
+            uint32_t value = bitmapWrapper.get();
+            while (value != FULL_WORD) {
+                uint32_t bit = __builtin_ctz(~value);
+                if (bitmapWrapper.compareAndSet(value, value | (1u << bit))) {
+                    if ((value | (1u << bit)) == FULL_WORD) {
+                        markIfFull(index);
+                    }
+
+                    searchHint = index;
+                    return index * 32 + bit;
+                }
+
+                value = bitmapWrapper.get();
+            }
+
+            markIfFull(index);
         }
     }
 
-    if (i == blocks) {
-        return INVALID_INDEX;
+    return INVALID_INDEX;
+}
+
+uint32_t AtomicBitmap::findAndUnset() {
+    for (uint32_t index = 0; index < arraySize; index++) {
+        Async::Atomic<uint32_t> bitmapWrapper(bitmap[index]);
+        uint32_t validMask = getValidMask(index);
+
+        uint32_t value = bitmapWrapper.get();
+        while ((value & validMask) != 0) {
+            uint32_t bit = __builtin_ctz(value & validMask);
+            if (bitmapWrapper.compareAndSet(value, value & ~(1u << bit))) {
+                Async::Atomic<uint32_t> summaryWrapper(summary[index / 32]);
+                summaryWrapper.bitReset(index % 32);
+                return index * 32 + bit;
+            }
+
+            value = bitmapWrapper.get();
+        }
     }
 
-    return i;
+    return INVALID_INDEX;
 }
 
-uint32_t AtomicBitmap::findAndUnset() {
-    uint32_t i;
+void AtomicBitmap::markIfFull(uint32_t index) {
+    Async::Atomic<uint32_t> bitmapWrapper(bitmap[index]);
+    if (bitmapWrapper.get() != FULL_WORD) {
+        return;
+    }
 
-    for (i = 0; i < blocks; i++) {
-        uint32_t index = i / 32;
-        uint32_t bit = i % 32;
+    Async::Atomic<uint32_t> summaryWrapper(summary[index / 32]);
+    summaryWrapper.bitSet(index % 32);
 
-        Async::Atomic<uint32_t> bitmapWrapper(bitmap[index]);
-        if (bitmapWrapper.bitTestAndReset(31 - bit)) {
-            break;
-        }
+    // A block may have been released in the meantime, without its summary bit being set yet -> Check again
+    if (bitmapWrapper.get() != FULL_WORD) {
+        summaryWrapper.bitReset(index % 32);
     }
+}
 
-    if (i == blocks) {
-        return INVALID_INDEX;
+uint32_t AtomicBitmap::getValidMask(uint32_t index) const {
+    if (index == arraySize - 1 && blocks % 32 != 0) {
+        return FULL_WORD >> (32 - blocks % 32);
     }
 
-    return i;
+    return FULL_WORD;
 }
 
 }
\ No newline at end of file
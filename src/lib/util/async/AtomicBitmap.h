@@ -34,7 +34,7 @@ public:
 
     AtomicBitmap &operator=(const AtomicBitmap &other) = delete;
 
-    ~AtomicBitmap() = default;
+    ~AtomicBitmap();
 
     [[nodiscard]] uint32_t getSize() const;
 
@@ -52,10 +52,29 @@ public:
 
 private:
 
+    void markIfFull(uint32_t index);
+
+    [[nodiscard]] uint32_t getValidMask(uint32_t index) const;
+
+    static const constexpr uint32_t FULL_WORD = 0xffffffff;
+
     uint32_t *bitmap = nullptr;
     uint32_t arraySize = 0;
     uint32_t blocks = 0;
 
+    /**
+     * Second level of the bitmap, containing one bit per word of the first level.
+     * A set bit means, that the corresponding word is (most likely) completely set and can be skipped by findAndSet().
+     * The summary is only a hint and is always verified against the first level.
+     */
+    uint32_t *summary = nullptr;
+    uint32_t summarySize = 0;
+
+    /**
+     * Next fit hint: Index of the word, which has been used for the last successful allocation.
+     */
+    uint32_t searchHint = 0;
+
 };
 
 }
@@ -15,25 +15,32 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>
  */
 
-#include "AddressSpaceCleaner.h"
+#include "Backoff.h"
 
-#include "kernel/service/MemoryService.h"
-#include "kernel/system/System.h"
-#include "kernel/service/ProcessService.h"
-#include "kernel/process/Process.h"
-#include "kernel/service/SchedulerService.h"
+#include "lib/util/async/Thread.h"
 
-namespace Kernel {
+namespace Util::Async {
 
-void AddressSpaceCleaner::run() {
-    auto &schedulerService = System::getService<SchedulerService>();
-    auto &currentProcess = System::getService<ProcessService>().getCurrentProcess();
-    while (currentProcess.getThreadCount() > 1) {
-        schedulerService.yield();
+void Backoff::pause() {
+    if (spins > MAX_SPINS) {
+        Thread::yield();
+        return;
     }
 
-    System::getService<MemoryService>().unmap(0, 0xbfffffff, 0);
-    schedulerService.cleanup(&currentProcess);
+    for (uint32_t i = 0; i < spins; i++) {
+        relax();
+    }
+
+    spins *= 2;
+}
+
+void Backoff::reset() {
+    spins = 1;
 }
 
-}
\ No newline at end of file
+void Backoff::relax() {
+    // 'pause' is encoded as 'rep nop', which also assembles for (and is ignored by) CPUs prior to the Pentium 4
+    asm volatile("rep; nop" ::: "memory");
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_BACKOFF_H
+#define HHUOS_BACKOFF_H
+
+#include <cstdint>
+
+namespace Util::Async {
+
+/**
+ * Exponential backoff for spinning locks.
+ * Each call to pause() spins for twice as many pause instructions as the previous one,
+ * until MAX_SPINS is reached. From then on, the current thread yields, so that a preempted lock holder
+ * can make progress on the same core.
+ */
+class Backoff {
+
+public:
+    /**
+     * Default Constructor.
+     */
+    Backoff() = default;
+
+    /**
+     * Copy Constructor.
+     */
+    Backoff(const Backoff &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    Backoff &operator=(const Backoff &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~Backoff() = default;
+
+    void pause();
+
+    void reset();
+
+    /**
+     * Execute the pause instruction, which tells the processor that it is running a spin-wait loop.
+     */
+    static void relax();
+
+    static const constexpr uint32_t MAX_SPINS = 1024;
+
+private:
+
+    uint32_t spins = 1;
+};
+
+}
+
+#endif
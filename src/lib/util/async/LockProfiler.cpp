@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "LockProfiler.h"
+
+#include "lib/util/async/Atomic.h"
+#include "lib/util/base/Address.h"
+#include "lib/util/base/Exception.h"
+
+namespace Util::Async {
+
+LockProfiler::Statistics LockProfiler::locks[MAX_LOCKS]{};
+uint32_t LockProfiler::lockCount = 0;
+
+LockProfiler::Statistics* LockProfiler::registerLock(const char *name) {
+    auto count = Atomic<uint32_t>(lockCount).get();
+    for (uint32_t i = 0; i < count; i++) {
+        if (locks[i].name != nullptr && Address<uint32_t>(locks[i].name).compareString(name) == 0) {
+            return &locks[i];
+        }
+    }
+
+    auto index = Atomic<uint32_t>(lockCount).fetchAndInc();
+    if (index >= MAX_LOCKS) {
+        Atomic<uint32_t>(lockCount).set(MAX_LOCKS);
+        return nullptr;
+    }
+
+    locks[index].name = name;
+    return &locks[index];
+}
+
+uint32_t LockProfiler::getLockCount() {
+    auto count = Atomic<uint32_t>(lockCount).get();
+    return count > MAX_LOCKS ? MAX_LOCKS : count;
+}
+
+const LockProfiler::Statistics& LockProfiler::getStatistics(uint32_t index) {
+    if (index >= getLockCount()) {
+        Exception::throwException(Exception::OUT_OF_BOUNDS, "LockProfiler: Index out of bounds!");
+    }
+
+    return locks[index];
+}
+
+void LockProfiler::reset() {
+    for (uint32_t i = 0; i < getLockCount(); i++) {
+        auto &statistics = locks[i];
+        statistics.acquisitions = 0;
+        statistics.contendedAcquisitions = 0;
+        statistics.spinIterations = 0;
+        statistics.maxHoldCycles = 0;
+    }
+}
+
+void LockProfiler::recordAcquisition(Statistics &statistics, uint32_t spinIterations) {
+    // Called while holding the lock, so no atomic operations are needed
+    statistics.acquisitions++;
+    if (spinIterations > 0) {
+        statistics.contendedAcquisitions++;
+        statistics.spinIterations = spinIterations > UINT32_MAX - statistics.spinIterations ? UINT32_MAX : statistics.spinIterations + spinIterations;
+    }
+}
+
+void LockProfiler::recordHoldTime(Statistics &statistics, uint64_t acquireTimestamp) {
+    auto holdCycles = readTimestamp() - acquireTimestamp;
+    if (holdCycles > statistics.maxHoldCycles) {
+        statistics.maxHoldCycles = holdCycles > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(holdCycles);
+    }
+}
+
+uint64_t LockProfiler::readTimestamp() {
+    uint32_t low, high;
+    asm volatile("rdtsc" : "=a"(low), "=d"(high));
+    return (static_cast<uint64_t>(high) << 32) | low;
+}
+
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_LOCKPROFILER_H
+#define HHUOS_LOCKPROFILER_H
+
+#include <cstdint>
+
+namespace Util::Async {
+
+/**
+ * Collects contention statistics for named spinlocks.
+ * Statistics are only recorded, if the system has been built with HHUOS_LOCK_PROFILING defined
+ * (e.g. via 'cmake -DHHUOS_LOCK_PROFILING=ON'). The hold time is measured with the time stamp counter.
+ */
+class LockProfiler {
+
+public:
+
+    struct Statistics {
+        const char *name;
+        uint32_t acquisitions;
+        uint32_t contendedAcquisitions;
+        uint32_t spinIterations;
+        uint32_t maxHoldCycles;
+    };
+
+    /**
+     * Default Constructor.
+     * Deleted, as this class has only static members.
+     */
+    LockProfiler() = delete;
+
+    /**
+     * Copy Constructor.
+     */
+    LockProfiler(const LockProfiler &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    LockProfiler &operator=(const LockProfiler &other) = delete;
+
+    /**
+     * Destructor.
+     * Deleted, as this class has only static members.
+     */
+    ~LockProfiler() = delete;
+
+    [[nodiscard]] static constexpr bool isEnabled() {
+#ifdef HHUOS_LOCK_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Get a statistics slot for a lock. Locks with the same name share a slot (e.g. one lock per scheduler instance).
+     *
+     * @return The slot, or nullptr if all slots are in use
+     */
+    static Statistics* registerLock(const char *name);
+
+    [[nodiscard]] static uint32_t getLockCount();
+
+    [[nodiscard]] static const Statistics& getStatistics(uint32_t index);
+
+    static void reset();
+
+    static void recordAcquisition(Statistics &statistics, uint32_t spinIterations);
+
+    static void recordHoldTime(Statistics &statistics, uint64_t acquireTimestamp);
+
+    [[nodiscard]] static uint64_t readTimestamp();
+
+    static const constexpr uint32_t MAX_LOCKS = 64;
+
+private:
+
+    static Statistics locks[MAX_LOCKS];
+    static uint32_t lockCount;
+};
+
+}
+
+#endif
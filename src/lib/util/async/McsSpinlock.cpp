@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "McsSpinlock.h"
+
+#include "lib/util/async/Atomic.h"
+#include "lib/util/async/Backoff.h"
+#include "lib/util/async/Thread.h"
+
+namespace Util::Async {
+
+#ifdef HHUOS_LOCK_PROFILING
+McsSpinlock::McsSpinlock(const char *name) : statistics(LockProfiler::registerLock(name)) {}
+#else
+McsSpinlock::McsSpinlock(const char *name) {}
+#endif
+
+void McsSpinlock::acquire() {
+    uint32_t spinIterations = 0;
+    if (!tryAcquire()) {
+        // A killed waiter would leave its node on a freed stack -> The kernel defers killing this thread, until it holds the lock
+        Thread::beginLockWait();
+        acquireQueued(spinIterations);
+        Thread::endLockWait();
+    }
+
+#ifdef HHUOS_LOCK_PROFILING
+    if (statistics != nullptr) {
+        LockProfiler::recordAcquisition(*statistics, spinIterations);
+        acquireTimestamp = LockProfiler::readTimestamp();
+    }
+#endif
+}
+
+void McsSpinlock::acquireQueued(uint32_t &spinIterations) {
+    Node node{nullptr, true};
+
+    auto *predecessor = exchangeTail(&node);
+    if (predecessor != nullptr) {
+        predecessor->next = &node;
+
+        Backoff backoff;
+        while (node.waiting) {
+            spinIterations++;
+            backoff.pause();
+        }
+    }
+
+    // The lock is held now -> Move our place in the queue from the stack into the embedded holder node.
+    // If the lock was free, the invariant 'tail == nullptr -> holder.next == nullptr' holds anyway.
+    holder.next = nullptr;
+    if (!compareAndSetTail(&node, &holder)) {
+        // Another thread has already enqueued behind us, but may not have linked itself yet
+        while (node.next == nullptr) {
+            Backoff::relax();
+        }
+
+        holder.next = node.next;
+    }
+}
+
+bool McsSpinlock::tryAcquire() {
+    // 'holder.next' is always nullptr while the lock is free, so it does not need to be touched
+    return compareAndSetTail(nullptr, &holder);
+}
+
+void McsSpinlock::release() {
+#ifdef HHUOS_LOCK_PROFILING
+    if (statistics != nullptr && acquireTimestamp != 0) {
+        LockProfiler::recordHoldTime(*statistics, acquireTimestamp);
+        acquireTimestamp = 0;
+    }
+#endif
+
+    if (holder.next == nullptr) {
+        if (compareAndSetTail(&holder, nullptr)) {
+            return;
+        }
+
+        // A new waiter has swapped the tail, but not yet linked itself to the holder node
+        while (holder.next == nullptr) {
+            Backoff::relax();
+        }
+    }
+
+    // The successor's node is invalid, as soon as it stops waiting -> Do not touch it afterwards
+    auto *successor = holder.next;
+    successor->waiting = false;
+}
+
+bool McsSpinlock::isLocked() {
+    return tail != nullptr;
+}
+
+McsSpinlock::Node* McsSpinlock::exchangeTail(McsSpinlock::Node *node) {
+    return reinterpret_cast<Node*>(Atomic<uint32_t>(reinterpret_cast<uint32_t&>(const_cast<Node*&>(tail))).getAndSet(reinterpret_cast<uint32_t>(node)));
+}
+
+bool McsSpinlock::compareAndSetTail(McsSpinlock::Node *expected, McsSpinlock::Node *node) {
+    return Atomic<uint32_t>(reinterpret_cast<uint32_t&>(const_cast<Node*&>(tail))).compareAndSet(reinterpret_cast<uint32_t>(expected), reinterpret_cast<uint32_t>(node));
+}
+
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_MCSSPINLOCK_H
+#define HHUOS_MCSSPINLOCK_H
+
+#include <cstdint>
+
+#include "lib/util/async/LockProfiler.h"
+#include "Lock.h"
+
+namespace Util::Async {
+
+/**
+ * A fair queue lock after Mellor-Crummey and Scott.
+ * Waiting threads form a linked list and each one spins on its own node, so that a release only
+ * touches the cache line of the next waiter. The queue node of a waiter lives on its stack. Once it has
+ * acquired the lock, its place in the queue is moved into a node embedded in the lock, so that
+ * acquire() and release() keep the plain Lock interface and may even be called by different threads
+ * (as done by the scheduler during a context switch).
+ * A queued waiter must not be killed, since its predecessor would write into the freed stack of the dead thread on release.
+ * Therefore, waiters are marked with Thread::beginLockWait() and the kernel defers killing them, until they hold the lock.
+ */
+class McsSpinlock : public Lock {
+
+public:
+    /**
+     * Default Constructor.
+     */
+    McsSpinlock() = default;
+
+    /**
+     * Constructor for a named lock, whose contention is recorded by the LockProfiler.
+     */
+    explicit McsSpinlock(const char *name);
+
+    /**
+     * Copy Constructor.
+     */
+    McsSpinlock(const McsSpinlock &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    McsSpinlock &operator=(const McsSpinlock &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~McsSpinlock() override = default;
+
+    void acquire() override;
+
+    bool tryAcquire() override;
+
+    void release() override;
+
+    bool isLocked() override;
+
+private:
+
+    struct Node {
+        Node *volatile next;
+        volatile bool waiting;
+    };
+
+    /**
+     * Enqueue a node on the stack and wait, until the lock is handed over to it.
+     */
+    void acquireQueued(uint32_t &spinIterations);
+
+    Node* exchangeTail(Node *node);
+
+    bool compareAndSetTail(Node *expected, Node *node);
+
+    // The last node in the queue, nullptr if the lock is free
+    Node *volatile tail = nullptr;
+    // Represents the current lock holder in the queue
+    Node holder{nullptr, false};
+
+#ifdef HHUOS_LOCK_PROFILING
+    LockProfiler::Statistics *statistics = nullptr;
+    uint64_t acquireTimestamp = 0;
+#endif
+};
+
+}
+
+#endif
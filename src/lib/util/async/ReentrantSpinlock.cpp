@@ -22,6 +22,8 @@
 
 namespace Util::Async {
 
+ReentrantSpinlock::ReentrantSpinlock(const char *name) : Spinlock(name) {}
+
 bool ReentrantSpinlock::tryAcquire() {
     auto currentThread = Thread::getCurrentThread();
     auto success = lockVarWrapper.compareAndSet(SPINLOCK_UNLOCK, currentThread.getId()) || lockVarWrapper.compareAndSet(currentThread.getId(), currentThread.getId());
@@ -39,6 +41,13 @@ void ReentrantSpinlock::release() {
     }
 
     if (depth == 0) {
+#ifdef HHUOS_LOCK_PROFILING
+        if (statistics != nullptr && acquireTimestamp != 0) {
+            LockProfiler::recordHoldTime(*statistics, acquireTimestamp);
+            acquireTimestamp = 0;
+        }
+#endif
+
         lockVarWrapper.compareAndSet(currentThread.getId(), SPINLOCK_UNLOCK);
     }
 }
@@ -32,6 +32,11 @@ public:
      */
     ReentrantSpinlock() = default;
 
+    /**
+     * Constructor for a named lock, whose contention is recorded by the LockProfiler.
+     */
+    explicit ReentrantSpinlock(const char *name);
+
     /**
      * Copy Constructor.
      */
@@ -22,7 +22,31 @@ namespace Util::Async {
 
 Spinlock::Spinlock() : lockVarWrapper(lockVar) {}
 
+#ifdef HHUOS_LOCK_PROFILING
+Spinlock::Spinlock(const char *name) : lockVarWrapper(lockVar), statistics(LockProfiler::registerLock(name)) {}
+#else
+Spinlock::Spinlock(const char *name) : lockVarWrapper(lockVar) {}
+#endif
+
 void Spinlock::acquire() {
+#ifdef HHUOS_LOCK_PROFILING
+    if (statistics != nullptr) {
+        uint32_t spinIterations = 0;
+        while (!tryAcquire()) {
+            spinIterations++;
+            Thread::yield();
+        }
+
+        LockProfiler::recordAcquisition(*statistics, spinIterations);
+        if (acquireTimestamp == 0) {
+            // Only the outermost acquisition of a reentrant lock starts the hold time
+            acquireTimestamp = LockProfiler::readTimestamp();
+        }
+
+        return;
+    }
+#endif
+
     while (!tryAcquire()) {
         Thread::yield();
     }
@@ -33,6 +57,13 @@ bool Spinlock::tryAcquire() {
 }
 
 void Spinlock::release() {
+#ifdef HHUOS_LOCK_PROFILING
+    if (statistics != nullptr && acquireTimestamp != 0) {
+        LockProfiler::recordHoldTime(*statistics, acquireTimestamp);
+        acquireTimestamp = 0;
+    }
+#endif
+
     lockVarWrapper.set(SPINLOCK_UNLOCK);
 }
 
@@ -21,6 +21,7 @@
 #include <cstdint>
 
 #include "lib/util/async/Atomic.h"
+#include "lib/util/async/LockProfiler.h"
 #include "Lock.h"
 
 namespace Util::Async {
@@ -37,6 +38,12 @@ public:
 
     Spinlock();
 
+    /**
+     * Constructor for a named lock, whose contention is recorded by the LockProfiler.
+     * Without HHUOS_LOCK_PROFILING, the name is ignored.
+     */
+    explicit Spinlock(const char *name);
+
     Spinlock(const Spinlock &other) = delete;
 
     Spinlock &operator=(const Spinlock &other) = delete;
@@ -56,6 +63,11 @@ protected:
     uint32_t lockVar = SPINLOCK_UNLOCK;
     Atomic<uint32_t> lockVarWrapper;
 
+#ifdef HHUOS_LOCK_PROFILING
+    LockProfiler::Statistics *statistics = nullptr;
+    uint64_t acquireTimestamp = 0;
+#endif
+
     static const constexpr uint32_t SPINLOCK_UNLOCK = UINT32_MAX;
     static const constexpr uint32_t SPINLOCK_LOCK = 0x01;
 };
@@ -47,6 +47,14 @@ void Thread::yield() {
     ::yield();
 }
 
+void Thread::beginLockWait() {
+    ::beginLockWait();
+}
+
+void Thread::endLockWait() {
+    ::endLockWait();
+}
+
 Thread Thread::createThread(const Util::String &name, Runnable *runnable) {
     return ::createThread(name, runnable);
 }
@@ -64,6 +64,15 @@ public:
 
     static void yield();
 
+    /**
+     * Mark the current thread as queued in a fair lock (see TicketSpinlock and McsSpinlock), until endLockWait() is called.
+     * Such a thread must not be killed, since it would never take its turn and all later waiters would spin forever.
+     * Instead, the kernel defers killing it until it has left the queue.
+     */
+    static void beginLockWait();
+
+    static void endLockWait();
+
     [[nodiscard]] uint32_t getId() const;
 
     void join() const;
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "TicketSpinlock.h"
+
+#include "lib/util/async/Atomic.h"
+#include "lib/util/async/Backoff.h"
+#include "lib/util/async/Thread.h"
+
+namespace Util::Async {
+
+#ifdef HHUOS_LOCK_PROFILING
+TicketSpinlock::TicketSpinlock(const char *name) : statistics(LockProfiler::registerLock(name)) {}
+#else
+TicketSpinlock::TicketSpinlock(const char *name) {}
+#endif
+
+void TicketSpinlock::acquire() {
+    uint32_t spinIterations = 0;
+    if (!tryAcquire()) {
+        // A killed waiter would never take its turn -> The kernel defers killing this thread, until it is served
+        Thread::beginLockWait();
+        auto ticket = Atomic<uint32_t>(nextTicket).fetchAndInc();
+        Backoff backoff;
+
+        while (nowServing != ticket) {
+            spinIterations++;
+            backoff.pause();
+        }
+
+        Thread::endLockWait();
+    }
+
+#ifdef HHUOS_LOCK_PROFILING
+    if (statistics != nullptr) {
+        LockProfiler::recordAcquisition(*statistics, spinIterations);
+        acquireTimestamp = LockProfiler::readTimestamp();
+    }
+#endif
+}
+
+bool TicketSpinlock::tryAcquire() {
+    // Only succeeds, if nobody holds or waits for the lock
+    uint32_t ticket = nowServing;
+    return Atomic<uint32_t>(nextTicket).compareAndSet(ticket, ticket + 1);
+}
+
+void TicketSpinlock::release() {
+#ifdef HHUOS_LOCK_PROFILING
+    if (statistics != nullptr && acquireTimestamp != 0) {
+        LockProfiler::recordHoldTime(*statistics, acquireTimestamp);
+        acquireTimestamp = 0;
+    }
+#endif
+
+    // Only the lock holder writes 'nowServing', so no locked instruction is needed
+    asm volatile("" ::: "memory");
+    nowServing = nowServing + 1;
+}
+
+bool TicketSpinlock::isLocked() {
+    return Atomic<uint32_t>(nextTicket).get() != nowServing;
+}
+
+}
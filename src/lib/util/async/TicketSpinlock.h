@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_TICKETSPINLOCK_H
+#define HHUOS_TICKETSPINLOCK_H
+
+#include <cstdint>
+
+#include "lib/util/async/LockProfiler.h"
+#include "Lock.h"
+
+namespace Util::Async {
+
+/**
+ * A fair spinlock, which grants the lock in the order of the acquire() calls.
+ * Each thread draws a ticket and spins (with backoff) until its number is served.
+ * A queued waiter must not be killed, since its ticket would never be served and all later waiters would spin forever.
+ * Therefore, waiters are marked with Thread::beginLockWait() and the kernel defers killing them, until they are served.
+ */
+class TicketSpinlock : public Lock {
+
+public:
+    /**
+     * Default Constructor.
+     */
+    TicketSpinlock() = default;
+
+    /**
+     * Constructor for a named lock, whose contention is recorded by the LockProfiler.
+     */
+    explicit TicketSpinlock(const char *name);
+
+    /**
+     * Copy Constructor.
+     */
+    TicketSpinlock(const TicketSpinlock &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    TicketSpinlock &operator=(const TicketSpinlock &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~TicketSpinlock() override = default;
+
+    void acquire() override;
+
+    bool tryAcquire() override;
+
+    void release() override;
+
+    bool isLocked() override;
+
+private:
+
+    uint32_t nextTicket = 0;
+    volatile uint32_t nowServing = 0;
+
+#ifdef HHUOS_LOCK_PROFILING
+    LockProfiler::Statistics *statistics = nullptr;
+    uint64_t acquireTimestamp = 0;
+#endif
+};
+
+}
+
+#endif
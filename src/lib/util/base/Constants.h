@@ -16,7 +16,7 @@
  */
 
 #include <cstdint>
-#include "FreeListMemoryManager.h"
+#include "SlabMemoryManager.h"
 
 #ifndef HHUOS_CONSTANTS_H
 #define HHUOS_CONSTANTS_H
@@ -26,7 +26,25 @@ namespace Util {
 // pagesize = 4KB
 static const constexpr uint32_t PAGESIZE = 0x1000;
 static const constexpr uint32_t USER_SPACE_MEMORY_MANAGER_ADDRESS = 0x1000;
-static const constexpr uint32_t USER_SPACE_STACK_INSTANCE_ADDRESS = USER_SPACE_MEMORY_MANAGER_ADDRESS + sizeof(FreeListMemoryManager);
+static const constexpr uint32_t USER_SPACE_STACK_INSTANCE_ADDRESS = USER_SPACE_MEMORY_MANAGER_ADDRESS + sizeof(SlabMemoryManager);
+
+// The memory manager and the main thread's stack instance must fit below the program start address (0x2000)
+static_assert(sizeof(SlabMemoryManager) <= PAGESIZE - 64, "User space memory manager is too large!");
+
+// User stacks are reserved at the end of user space and committed on demand by the page fault handler.
+// The main thread's stack is located at the top, followed by the stacks of all other threads.
+// The lowest page of each stack is a guard page, which is never mapped.
+static const constexpr uint32_t USER_SPACE_STACK_AREA_END = 0xbfffffff;
+static const constexpr uint32_t MAIN_USER_STACK_SIZE = 8 * 1024 * 1024;
+static const constexpr uint32_t USER_STACK_SIZE = 1024 * 1024;
+static const constexpr uint32_t MAX_USER_STACKS = 56;
+static const constexpr uint32_t MAIN_USER_STACK_ADDRESS = USER_SPACE_STACK_AREA_END - MAIN_USER_STACK_SIZE + 1;
+static const constexpr uint32_t USER_SPACE_STACK_AREA_START = MAIN_USER_STACK_ADDRESS - MAX_USER_STACKS * USER_STACK_SIZE;
+
+// Shared libraries are mapped below the user stacks, in the order they are needed by the executable.
+// The heap ends below this area.
+static const constexpr uint32_t USER_SPACE_LIBRARY_AREA_END = USER_SPACE_STACK_AREA_START - 1;
+static const constexpr uint32_t USER_SPACE_LIBRARY_AREA_START = 0xb0000000;
 
 }
 
@@ -20,7 +20,7 @@
 
 #include <cstdint>
 
-#include "lib/util/async/Spinlock.h"
+#include "lib/util/async/TicketSpinlock.h"
 #include "HeapMemoryManager.h"
 #include "lib/util/base/String.h"
 #include "lib/util/reflection/Prototype.h"
@@ -156,7 +156,7 @@ private:
     uint8_t *startAddress{};
     uint8_t *endAddress{};
 
-    Util::Async::Spinlock lock;
+    Util::Async::TicketSpinlock lock{"FreeListMemoryManager"};
     FreeListHeader *firstChunk = nullptr;
     uint32_t unusedMemory = 0;
     bool unmapFreedMemory = true;
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "SlabMemoryManager.h"
+
+#include "lib/util/base/Address.h"
+#include "lib/util/base/Constants.h"
+
+namespace Util {
+
+const uint32_t SlabMemoryManager::sizeClasses[SIZE_CLASSES] = { 16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048 };
+
+void SlabMemoryManager::initialize(uint8_t *startAddress, uint8_t *endAddress) {
+    // Use a quarter of the heap for slabs; Pages are mapped on demand, so unused parts of the arena do not occupy memory
+    auto heapSize = static_cast<uint32_t>(endAddress - startAddress) + 1;
+    auto arenaSize = (heapSize / 4) & ~(SLAB_SIZE - 1);
+    if (arenaSize > MAX_ARENA_SIZE) {
+        arenaSize = MAX_ARENA_SIZE;
+    }
+
+    arenaEnd = endAddress + 1;
+    if (arenaSize > 0) {
+        arenaEnd = reinterpret_cast<uint8_t*>(reinterpret_cast<uint32_t>(arenaEnd) & ~(SLAB_SIZE - 1));
+    }
+
+    arenaStart = arenaEnd - arenaSize;
+    arenaPosition = arenaStart;
+    largeObjectManager.initialize(startAddress, arenaStart - 1);
+}
+
+void* SlabMemoryManager::allocateMemory(uint32_t size, uint32_t alignment) {
+    auto sizeClass = getSizeClass(size, alignment);
+    if (sizeClass == SIZE_CLASSES) {
+        return largeObjectManager.allocateMemory(size, alignment);
+    }
+
+    auto &cache = getThreadCache(sizeClass);
+    cache.lock.acquire();
+
+    if (cache.freeObjects == nullptr) {
+        refillCache(cache, sizeClass);
+    }
+
+    auto *object = cache.freeObjects;
+    if (object == nullptr) {
+        // The arena is exhausted
+        cache.lock.release();
+        return largeObjectManager.allocateMemory(size, alignment);
+    }
+
+    cache.freeObjects = object->next;
+    cache.count--;
+    cache.lock.release();
+
+    return object;
+}
+
+void* SlabMemoryManager::reallocateMemory(void *pointer, uint32_t size, uint32_t alignment) {
+    if (pointer == nullptr) {
+        return allocateMemory(size, alignment);
+    }
+
+    if (!isSlabObject(pointer)) {
+        return largeObjectManager.reallocateMemory(pointer, size, alignment);
+    }
+
+    const auto *slab = reinterpret_cast<const SlabHeader*>(reinterpret_cast<uint32_t>(pointer) & ~(SLAB_SIZE - 1));
+    auto objectSize = sizeClasses[slab->sizeClass];
+    if (size <= objectSize && alignment <= OBJECT_ALIGNMENT) {
+        return pointer;
+    }
+
+    auto *newPointer = allocateMemory(size, alignment);
+    if (newPointer == nullptr) {
+        return nullptr;
+    }
+
+    Address<uint32_t>(newPointer).copyRange(Address<uint32_t>(pointer), size < objectSize ? size : objectSize);
+    freeMemory(pointer, alignment);
+
+    return newPointer;
+}
+
+void SlabMemoryManager::freeMemory(void *pointer, uint32_t alignment) {
+    if (!isSlabObject(pointer)) {
+        largeObjectManager.freeMemory(pointer, alignment);
+        return;
+    }
+
+    const auto *slab = reinterpret_cast<const SlabHeader*>(reinterpret_cast<uint32_t>(pointer) & ~(SLAB_SIZE - 1));
+    auto sizeClass = slab->sizeClass;
+    auto &cache = getThreadCache(sizeClass);
+    auto *object = static_cast<FreeObject*>(pointer);
+
+    cache.lock.acquire();
+    object->next = cache.freeObjects;
+    cache.freeObjects = object;
+    cache.count++;
+
+    if (cache.count > 2 * getBatchSize(sizeClass)) {
+        drainCache(cache, sizeClass);
+    }
+
+    cache.lock.release();
+}
+
+uint32_t SlabMemoryManager::getTotalMemory() const {
+    return largeObjectManager.getTotalMemory() + (arenaEnd - arenaStart);
+}
+
+uint32_t SlabMemoryManager::getFreeMemory() const {
+    return largeObjectManager.getFreeMemory() + (arenaEnd - arenaPosition);
+}
+
+uint8_t* SlabMemoryManager::getStartAddress() const {
+    return largeObjectManager.getStartAddress();
+}
+
+uint8_t* SlabMemoryManager::getEndAddress() const {
+    return arenaEnd - 1;
+}
+
+uint32_t SlabMemoryManager::getSizeClass(uint32_t size, uint32_t alignment) {
+    if (size == 0 || alignment > OBJECT_ALIGNMENT) {
+        return SIZE_CLASSES;
+    }
+
+    for (uint32_t i = 0; i < SIZE_CLASSES; i++) {
+        if (size <= sizeClasses[i]) {
+            return i;
+        }
+    }
+
+    return SIZE_CLASSES;
+}
+
+uint32_t SlabMemoryManager::getBatchSize(uint32_t sizeClass) {
+    auto batchSize = 4096 / sizeClasses[sizeClass];
+    if (batchSize < 4) {
+        return 4;
+    }
+
+    return batchSize > 32 ? 32 : batchSize;
+}
+
+bool SlabMemoryManager::isSlabObject(const void *pointer) const {
+    return pointer >= arenaStart && pointer < arenaEnd;
+}
+
+SlabMemoryManager::ThreadCache& SlabMemoryManager::getThreadCache(uint32_t sizeClass) {
+    uint32_t stackPointer;
+    asm volatile ("mov %%esp, %0" : "=r"(stackPointer));
+
+    // Each thread owns a fixed stack slot for its whole lifetime, which identifies it without a system call.
+    // The main thread's stack is larger than a slot and gets the index after the last slot.
+    uint32_t slot = MAX_USER_STACKS;
+    if (stackPointer >= USER_SPACE_STACK_AREA_START && stackPointer < MAIN_USER_STACK_ADDRESS) {
+        slot = (stackPointer - USER_SPACE_STACK_AREA_START) / USER_STACK_SIZE;
+    }
+
+    return threadCaches[slot % THREAD_CACHES][sizeClass];
+}
+
+void SlabMemoryManager::refillCache(ThreadCache &cache, uint32_t sizeClass) {
+    auto &pool = centralPools[sizeClass];
+    auto objectSize = sizeClasses[sizeClass];
+    auto batchSize = getBatchSize(sizeClass);
+
+    pool.lock.acquire();
+    for (uint32_t i = 0; i < batchSize; i++) {
+        FreeObject *object;
+        if (pool.freeObjects != nullptr) {
+            object = pool.freeObjects;
+            pool.freeObjects = object->next;
+        } else {
+            if (static_cast<uint32_t>(pool.slabEnd - pool.slabPosition) < objectSize) {
+                auto *slab = allocateSlab(sizeClass);
+                if (slab == nullptr) {
+                    break;
+                }
+
+                pool.slabPosition = slab + sizeof(SlabHeader);
+                pool.slabEnd = slab + SLAB_SIZE;
+            }
+
+            object = reinterpret_cast<FreeObject*>(pool.slabPosition);
+            pool.slabPosition += objectSize;
+        }
+
+        object->next = cache.freeObjects;
+        cache.freeObjects = object;
+        cache.count++;
+    }
+    pool.lock.release();
+}
+
+void SlabMemoryManager::drainCache(ThreadCache &cache, uint32_t sizeClass) {
+    auto &pool = centralPools[sizeClass];
+    auto batchSize = getBatchSize(sizeClass);
+
+    // Detach a batch from the cache first, so that the central pool is only locked for splicing it in
+    auto *first = cache.freeObjects;
+    auto *last = first;
+    for (uint32_t i = 1; i < batchSize; i++) {
+        last = last->next;
+    }
+
+    cache.freeObjects = last->next;
+    cache.count -= batchSize;
+
+    pool.lock.acquire();
+    last->next = pool.freeObjects;
+    pool.freeObjects = first;
+    pool.lock.release();
+}
+
+uint8_t* SlabMemoryManager::allocateSlab(uint32_t sizeClass) {
+    arenaLock.acquire();
+    if (static_cast<uint32_t>(arenaEnd - arenaPosition) < SLAB_SIZE) {
+        arenaLock.release();
+        return nullptr;
+    }
+
+    auto *slab = arenaPosition;
+    arenaPosition += SLAB_SIZE;
+    arenaLock.release();
+
+    reinterpret_cast<SlabHeader*>(slab)->sizeClass = sizeClass;
+    return slab;
+}
+
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_SLABMEMORYMANAGER_H
+#define HHUOS_SLABMEMORYMANAGER_H
+
+#include <cstdint>
+
+#include "lib/util/async/Spinlock.h"
+#include "FreeListMemoryManager.h"
+#include "HeapMemoryManager.h"
+#include "lib/util/base/String.h"
+#include "lib/util/reflection/Prototype.h"
+
+namespace Util {
+
+/**
+ * Heap memory manager, which serves small allocations from size classes and large allocations from a FreeListMemoryManager.
+ *
+ * Small objects are carved from 64 KiB slabs, located in a dedicated arena at the end of the heap.
+ * Each size class has a central pool (free objects and the remainder of the current slab), protected by its own lock.
+ * In front of the central pools sit a few thread caches, which hand out and take back objects in batches.
+ * There is no thread local storage, so a thread's cache is selected by its user stack slot, which stays the same for the thread's lifetime.
+ * With more threads than caches, several threads share a cache, so each cache is still protected by its own lock.
+ * Freed objects stay in their size class and are not returned to the arena.
+ */
+class SlabMemoryManager : public HeapMemoryManager {
+
+public:
+    /**
+     * Default Constructor.
+     */
+    SlabMemoryManager() = default;
+
+    /**
+     * Copy Constructor.
+     */
+    SlabMemoryManager(const SlabMemoryManager &copy) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    SlabMemoryManager& operator=(const SlabMemoryManager &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~SlabMemoryManager() override = default;
+
+    PROTOTYPE_IMPLEMENT_CLONE(SlabMemoryManager);
+
+    PROTOTYPE_IMPLEMENT_GET_CLASS_NAME("Util::SlabMemoryManager")
+
+    /**
+     * Overriding function from HeapMemoryManager.
+     */
+    void initialize(uint8_t *startAddress, uint8_t *endAddress) override;
+
+    /**
+     * Overriding function from HeapMemoryManager.
+     */
+    [[nodiscard]] void* allocateMemory(uint32_t size, uint32_t alignment) override;
+
+    /**
+     * Overriding function from HeapMemoryManager.
+     */
+    [[nodiscard]] void* reallocateMemory(void *pointer, uint32_t size, uint32_t alignment) override;
+
+    /**
+     * Overriding function from HeapMemoryManager.
+     */
+    void freeMemory(void *pointer, uint32_t alignment) override;
+
+    /**
+     * Overriding function from MemoryManager.
+     */
+    [[nodiscard]] uint32_t getTotalMemory() const override;
+
+    /**
+     * Overriding function from MemoryManager.
+     * Objects in the caches and central pools are counted as used.
+     */
+    [[nodiscard]] uint32_t getFreeMemory() const override;
+
+    /**
+     * Overriding function from MemoryManager.
+     */
+    [[nodiscard]] uint8_t* getStartAddress() const override;
+
+    /**
+     * Overriding function from MemoryManager.
+     */
+    [[nodiscard]] uint8_t* getEndAddress() const override;
+
+    static const constexpr uint32_t SLAB_SIZE = 0x10000;
+    static const constexpr uint32_t MAX_ARENA_SIZE = 0x20000000;
+    static const constexpr uint32_t OBJECT_ALIGNMENT = 16;
+    static const constexpr uint32_t SIZE_CLASSES = 14;
+    static const constexpr uint32_t THREAD_CACHES = 4;
+
+private:
+
+    struct FreeObject {
+        FreeObject *next;
+    };
+
+    struct SlabHeader {
+        uint32_t sizeClass;
+        uint8_t padding[OBJECT_ALIGNMENT - sizeof(uint32_t)];
+    };
+
+    struct CentralPool {
+        Async::Spinlock lock;
+        FreeObject *freeObjects = nullptr;
+        uint8_t *slabPosition = nullptr;
+        uint8_t *slabEnd = nullptr;
+    };
+
+    struct ThreadCache {
+        Async::Spinlock lock;
+        FreeObject *freeObjects = nullptr;
+        uint32_t count = 0;
+    };
+
+    /**
+     * Get the size class, which fits an allocation.
+     *
+     * @return The size class or SIZE_CLASSES, if the allocation must be served by the free list
+     */
+    static uint32_t getSizeClass(uint32_t size, uint32_t alignment);
+
+    /**
+     * Get the number of objects, which are moved between a thread cache and the central pool at once.
+     */
+    static uint32_t getBatchSize(uint32_t sizeClass);
+
+    [[nodiscard]] bool isSlabObject(const void *pointer) const;
+
+    ThreadCache& getThreadCache(uint32_t sizeClass);
+
+    /**
+     * Move up to a batch of objects from the central pool into a thread cache. Must be called with the cache's lock held.
+     */
+    void refillCache(ThreadCache &cache, uint32_t sizeClass);
+
+    /**
+     * Move a batch of objects from a thread cache back to the central pool. Must be called with the cache's lock held.
+     */
+    void drainCache(ThreadCache &cache, uint32_t sizeClass);
+
+    /**
+     * Take a new slab from the arena.
+     *
+     * @return The slab or nullptr, if the arena is exhausted
+     */
+    uint8_t* allocateSlab(uint32_t sizeClass);
+
+    FreeListMemoryManager largeObjectManager;
+
+    uint8_t *arenaStart = nullptr;
+    uint8_t *arenaEnd = nullptr;
+    uint8_t *arenaPosition = nullptr;
+    Async::Spinlock arenaLock;
+
+    CentralPool centralPools[SIZE_CLASSES];
+    ThreadCache threadCaches[THREAD_CACHES][SIZE_CLASSES];
+
+    static const uint32_t sizeClasses[SIZE_CLASSES];
+};
+
+}
+
+#endif
@@ -70,7 +70,9 @@ public:
         GET_SYSTEM_TIME,
         SET_DATE,
         GET_CURRENT_DATE,
-        SHUTDOWN
+        SHUTDOWN,
+        SYNC,
+        SYNC_FILE
     };
 
     /**
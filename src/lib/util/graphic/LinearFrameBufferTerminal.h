@@ -98,7 +98,7 @@ private:
 
     char cursor;
     CursorRunnable *cursorRunnable = nullptr;
-    Util::Async::Spinlock cursorLock;
+    Util::Async::Spinlock cursorLock{"Terminal"};
 };
 
 }
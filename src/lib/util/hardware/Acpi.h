@@ -194,6 +194,20 @@ public:
         ApicStructureHeader apicStructure; // Is a list
     } __attribute__ ((packed));
 
+    struct ConfigurationSpaceAllocation {
+        uint64_t baseAddress; // Enhanced configuration access mechanism (ECAM) base address
+        uint16_t pciSegmentGroup;
+        uint8_t startBus;
+        uint8_t endBus;
+        uint32_t reserved;
+    } __attribute__ ((packed));
+
+    struct Mcfg {
+        SdtHeader header;
+        uint64_t reserved;
+        ConfigurationSpaceAllocation allocations[]; // Length is determined by header.length
+    } __attribute__ ((packed));
+
     /**
      * Default Constructor.
      * Deleted, as this class has only static members.
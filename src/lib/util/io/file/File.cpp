@@ -130,6 +130,15 @@ bool File::control(uint32_t request, const Array<uint32_t> &parameters) {
     return ::controlFile(fileDescriptor, request, parameters);
 }
 
+bool File::sync() {
+    ensureFileIsOpened();
+    if (fileDescriptor < 0) {
+        Util::Exception::throwException(Exception::INVALID_ARGUMENT, "File: Could not open file!");
+    }
+
+    return ::syncFile(fileDescriptor);
+}
+
 Util::String File::getCanonicalPath(const Util::String &path) {
     if (path.isEmpty()) {
         return "";
@@ -185,6 +194,14 @@ void File::close(int32_t fileDescriptor) {
     return ::closeFile(fileDescriptor);
 }
 
+bool File::sync(int32_t fileDescriptor) {
+    return ::syncFile(fileDescriptor);
+}
+
+bool File::syncAll() {
+    return ::syncFilesystem();
+}
+
 bool File::changeDirectory(const Util::String &path) {
     return ::changeDirectory(path);
 }
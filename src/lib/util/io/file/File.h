@@ -83,6 +83,8 @@ public:
 
     [[nodiscard]] bool control(uint32_t request, const Util::Array<uint32_t> &parameters);
 
+    bool sync();
+
     [[nodiscard]] static String getCanonicalPath(const Util::String &path);
 
     [[nodiscard]] static File getCurrentWorkingDirectory();
@@ -95,6 +97,10 @@ public:
 
     void static close(int32_t fileDescriptor);
 
+    bool static sync(int32_t fileDescriptor);
+
+    static bool syncAll();
+
     static bool mount(const Util::String &device, const Util::String &targetPath, const Util::String &driverName);
 
     static bool unmount(const Util::String &path);
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "DynamicObject.h"
+
+#include "lib/util/base/Address.h"
+#include "lib/util/base/Exception.h"
+
+namespace Util::Io::Elf {
+
+DynamicObject::DynamicObject(uint32_t baseAddress, const DynamicEntry *dynamic) : baseAddress(baseAddress), dynamic(dynamic) {
+    for (const auto *entry = dynamic; entry->tag != DynamicTag::NONE; entry++) {
+        switch (entry->tag) {
+            case DynamicTag::NEEDED:
+                neededLibraryCount++;
+                break;
+            case DynamicTag::STRTAB:
+                stringTable = reinterpret_cast<const char*>(baseAddress + entry->value);
+                break;
+            case DynamicTag::SYMTAB:
+                symbolTable = reinterpret_cast<const SymbolEntry*>(baseAddress + entry->value);
+                break;
+            case DynamicTag::HASH:
+                hashTable = reinterpret_cast<const uint32_t*>(baseAddress + entry->value);
+                break;
+            case DynamicTag::REL:
+                relocations = reinterpret_cast<const RelocationEntry*>(baseAddress + entry->value);
+                break;
+            case DynamicTag::RELSZ:
+                relocationsSize = entry->value;
+                break;
+            case DynamicTag::JMPREL:
+                pltRelocations = reinterpret_cast<const RelocationEntry*>(baseAddress + entry->value);
+                break;
+            case DynamicTag::PLTRELSZ:
+                pltRelocationsSize = entry->value;
+                break;
+            case DynamicTag::PLTREL:
+                if (entry->value != static_cast<uint32_t>(DynamicTag::REL)) {
+                    Util::Exception::throwException(Util::Exception::UNSUPPORTED_OPERATION, "Elf: Only REL relocations are supported!");
+                }
+                break;
+            case DynamicTag::RELA:
+                Util::Exception::throwException(Util::Exception::UNSUPPORTED_OPERATION, "Elf: Only REL relocations are supported!");
+            case DynamicTag::TEXTREL:
+                // Read-only pages are shared between processes and must never be written
+                Util::Exception::throwException(Util::Exception::UNSUPPORTED_OPERATION, "Elf: Text relocations are not supported (compile with -fPIC)!");
+            case DynamicTag::INIT:
+                initFunction = baseAddress + entry->value;
+                break;
+            case DynamicTag::INIT_ARRAY:
+                initArray = reinterpret_cast<const uint32_t*>(baseAddress + entry->value);
+                break;
+            case DynamicTag::INIT_ARRAYSZ:
+                initArraySize = entry->value / sizeof(uint32_t);
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (stringTable == nullptr || symbolTable == nullptr) {
+        Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Elf: Missing dynamic symbol table!");
+    }
+}
+
+uint32_t DynamicObject::getBaseAddress() const {
+    return baseAddress;
+}
+
+Util::Array<Util::String> DynamicObject::getNeededLibraries() const {
+    auto libraries = Util::Array<Util::String>(neededLibraryCount);
+    uint32_t i = 0;
+    for (const auto *entry = dynamic; entry->tag != DynamicTag::NONE; entry++) {
+        if (entry->tag == DynamicTag::NEEDED) {
+            libraries[i++] = Util::String(stringTable + entry->value);
+        }
+    }
+
+    return libraries;
+}
+
+const SymbolEntry* DynamicObject::findSymbol(const char *name) const {
+    if (hashTable == nullptr) {
+        return nullptr;
+    }
+
+    // Hash table layout: bucket count, chain count, buckets, chains
+    uint32_t bucketCount = hashTable[0];
+    const uint32_t *buckets = hashTable + 2;
+    const uint32_t *chains = buckets + bucketCount;
+
+    for (uint32_t index = buckets[hash(name) % bucketCount]; index != 0; index = chains[index]) {
+        const auto &symbol = symbolTable[index];
+        if (!symbol.isDefined() || symbol.getSymbolBinding() == SymbolBinding::LOCAL) {
+            continue;
+        }
+
+        if (Util::Address<uint32_t>(stringTable + symbol.nameOffset).compareString(name) == 0) {
+            return &symbol;
+        }
+    }
+
+    return nullptr;
+}
+
+void DynamicObject::relocate(const Util::Array<DynamicObject*> &scope) const {
+    relocate(relocations, relocationsSize, scope);
+    relocate(pltRelocations, pltRelocationsSize, scope);
+}
+
+Util::Array<uint32_t> DynamicObject::getInitializers() const {
+    uint32_t count = (initFunction != 0 ? 1 : 0) + initArraySize;
+    auto initializers = Util::Array<uint32_t>(count);
+
+    uint32_t i = 0;
+    if (initFunction != 0) {
+        initializers[i++] = initFunction;
+    }
+
+    for (uint32_t j = 0; j < initArraySize; j++) {
+        initializers[i++] = initArray[j];
+    }
+
+    return initializers;
+}
+
+void DynamicObject::relocate(const RelocationEntry *relocationTable, uint32_t size, const Util::Array<DynamicObject*> &scope) const {
+    for (uint32_t i = 0; i < size / sizeof(RelocationEntry); i++) {
+        const auto &relocation = relocationTable[i];
+        auto *target = reinterpret_cast<uint32_t*>(baseAddress + relocation.offset);
+        uint32_t symbolSize = 0;
+
+        // REL relocations keep their addend at the target address
+        switch (relocation.getType()) {
+            case RelocationType::R_386_NONE:
+                break;
+            case RelocationType::R_386_RELATIVE:
+                *target += baseAddress;
+                break;
+            case RelocationType::R_386_32:
+                *target += resolveSymbol(relocation.getSymbolIndex(), scope, false, symbolSize);
+                break;
+            case RelocationType::R_386_PC32:
+                *target += resolveSymbol(relocation.getSymbolIndex(), scope, false, symbolSize) - reinterpret_cast<uint32_t>(target);
+                break;
+            case RelocationType::R_386_GLOB_DAT:
+            case RelocationType::R_386_JMP_SLOT:
+                *target = resolveSymbol(relocation.getSymbolIndex(), scope, false, symbolSize);
+                break;
+            case RelocationType::R_386_COPY: {
+                // The executable holds its own copy of a library variable, which must be initialized from the library's data
+                auto source = resolveSymbol(relocation.getSymbolIndex(), scope, true, symbolSize);
+                Util::Address<uint32_t>(target).copyRange(Util::Address<uint32_t>(source), symbolSize);
+                break;
+            }
+            default:
+                Util::Exception::throwException(Util::Exception::UNSUPPORTED_OPERATION, "Elf: Unsupported relocation type!");
+        }
+    }
+}
+
+uint32_t DynamicObject::resolveSymbol(uint32_t index, const Util::Array<DynamicObject*> &scope, bool skipSelf, uint32_t &symbolSize) const {
+    const auto &symbol = symbolTable[index];
+    if (symbol.getSymbolBinding() == SymbolBinding::LOCAL) {
+        symbolSize = symbol.size;
+        return baseAddress + symbol.value;
+    }
+
+    const auto *name = stringTable + symbol.nameOffset;
+    for (const auto *object : scope) {
+        if (skipSelf && object == this) {
+            continue;
+        }
+
+        const auto *definition = object->findSymbol(name);
+        if (definition != nullptr) {
+            symbolSize = definition->size;
+            return object->baseAddress + definition->value;
+        }
+    }
+
+    // Unresolved weak references evaluate to 0
+    if (symbol.getSymbolBinding() == SymbolBinding::WEAK) {
+        symbolSize = 0;
+        return 0;
+    }
+
+    Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Elf: Undefined symbol!");
+}
+
+uint32_t DynamicObject::hash(const char *name) {
+    uint32_t hash = 0;
+    while (*name != '\0') {
+        hash = (hash << 4) + static_cast<uint8_t>(*name++);
+        uint32_t high = hash & 0xf0000000;
+        if (high != 0) {
+            hash ^= high >> 24;
+        }
+
+        hash &= ~high;
+    }
+
+    return hash;
+}
+
+}
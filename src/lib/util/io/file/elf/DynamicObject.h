@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_DYNAMICOBJECT_H
+#define HHUOS_DYNAMICOBJECT_H
+
+#include <cstdint>
+
+#include "lib/util/collection/Array.h"
+#include "lib/util/base/String.h"
+#include "lib/util/io/file/elf/File.h"
+
+namespace Util::Io::Elf {
+
+/**
+ * Dynamic linking information (PT_DYNAMIC) of an executable or shared library, which has already been mapped into
+ * the current address space. All tables are accessed in place, so the object must remain mapped while it is used.
+ *
+ * Only i386 REL relocations are supported. Symbols are looked up via the System V hash table (DT_HASH),
+ * so objects must be linked with '--hash-style=sysv' (or 'both').
+ */
+class DynamicObject {
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param baseAddress The difference between the load address and the link address (0 for executables)
+     * @param dynamic The mapped dynamic section
+     */
+    DynamicObject(uint32_t baseAddress, const DynamicEntry *dynamic);
+
+    /**
+     * Copy Constructor.
+     */
+    DynamicObject(const DynamicObject &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    DynamicObject &operator=(const DynamicObject &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~DynamicObject() = default;
+
+    [[nodiscard]] uint32_t getBaseAddress() const;
+
+    /**
+     * Get the names of all shared libraries this object depends on (DT_NEEDED).
+     */
+    [[nodiscard]] Util::Array<Util::String> getNeededLibraries() const;
+
+    /**
+     * Find a symbol, which is defined and exported by this object.
+     *
+     * @return The symbol, or nullptr if this object does not define it
+     */
+    [[nodiscard]] const SymbolEntry* findSymbol(const char *name) const;
+
+    /**
+     * Apply all relocations (including the PLT relocations, which are bound immediately).
+     * Symbols are resolved in the order of the scope, which should start with the executable,
+     * followed by the libraries in load order. Libraries should be relocated before the objects depending on them,
+     * so that copy relocations see relocated data.
+     *
+     * @param scope All objects loaded into the address space
+     */
+    void relocate(const Util::Array<DynamicObject*> &scope) const;
+
+    /**
+     * Get the addresses of all initialization functions (DT_INIT followed by DT_INIT_ARRAY).
+     * The addresses are only valid after the object has been relocated.
+     */
+    [[nodiscard]] Util::Array<uint32_t> getInitializers() const;
+
+private:
+
+    void relocate(const RelocationEntry *relocationTable, uint32_t size, const Util::Array<DynamicObject*> &scope) const;
+
+    [[nodiscard]] uint32_t resolveSymbol(uint32_t index, const Util::Array<DynamicObject*> &scope, bool skipSelf, uint32_t &symbolSize) const;
+
+    static uint32_t hash(const char *name);
+
+    uint32_t baseAddress;
+    const char *stringTable = nullptr;
+    const SymbolEntry *symbolTable = nullptr;
+    const uint32_t *hashTable = nullptr;
+    const RelocationEntry *relocations = nullptr;
+    uint32_t relocationsSize = 0;
+    const RelocationEntry *pltRelocations = nullptr;
+    uint32_t pltRelocationsSize = 0;
+    uint32_t initFunction = 0;
+    const uint32_t *initArray = nullptr;
+    uint32_t initArraySize = 0;
+    uint32_t neededLibraryCount = 0;
+    const DynamicEntry *dynamic;
+};
+
+}
+
+#endif
@@ -61,6 +61,10 @@ SymbolType SymbolEntry::getSymbolType() const {
     return SymbolType(info & 0x0FU);
 }
 
+bool SymbolEntry::isDefined() const {
+    return section != 0;
+}
+
 File::File(uint8_t *buffer) : buffer(buffer), fileHeader(*reinterpret_cast<FileHeader*>(buffer)) {
     if (!fileHeader.isValid()) {
         Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Elf: Invalid file!");
@@ -60,6 +60,12 @@ enum class ProgramHeaderType : uint32_t {
     PHDR = 0x06,
 };
 
+enum ProgramHeaderFlag : uint32_t {
+    EXECUTABLE = 0x01,
+    WRITABLE = 0x02,
+    READABLE = 0x04
+};
+
 enum class MachineType : uint16_t {
     X86 = 0x03
 };
@@ -111,7 +117,12 @@ enum class DynamicTag : uint32_t {
     PLTREL = 0x14,
     DEBUG = 0x15,
     TEXTREL = 0x16,
-    JMPREL = 0x17
+    JMPREL = 0x17,
+    BIND_NOW = 0x18,
+    INIT_ARRAY = 0x19,
+    FINI_ARRAY = 0x1A,
+    INIT_ARRAYSZ = 0x1B,
+    FINI_ARRAYSZ = 0x1C
 };
 
 enum class SymbolType : uint8_t {
@@ -195,6 +206,7 @@ struct SymbolEntry {
 
     [[nodiscard]] SymbolBinding getSymbolBinding() const;
     [[nodiscard]] SymbolType getSymbolType() const;
+    [[nodiscard]] bool isDefined() const;
 } __attribute__((packed));
 
 struct RelocationEntry {
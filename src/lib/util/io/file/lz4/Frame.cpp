@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Frame.h"
+
+#include "lib/util/base/Address.h"
+#include "lib/util/base/Exception.h"
+
+namespace Util::Io::Lz4 {
+
+Frame::Frame(const uint8_t *frame, uint32_t frameSize) : frame(frame), frameSize(frameSize) {
+    if (!isSupported(frame, frameSize)) {
+        Util::Exception::throwException(Util::Exception::UNSUPPORTED_OPERATION, "Lz4: Unsupported frame!");
+    }
+
+    // Frame descriptor: Magic number (4 bytes), flags, block descriptor, content size (8 bytes), header checksum
+    blockChecksums = (frame[4] & BLOCK_CHECKSUM) != 0;
+    contentSize = readLittleEndian(frame + 6);
+    position = 15;
+}
+
+Frame::~Frame() {
+    delete[] content;
+}
+
+bool Frame::isSupported(const uint8_t *data, uint32_t size) {
+    if (size < 15 || readLittleEndian(data) != MAGIC) {
+        return false;
+    }
+
+    auto flags = data[4];
+    return (flags & VERSION_MASK) == VERSION && (flags & CONTENT_SIZE) != 0 && (flags & DICTIONARY_ID) == 0 && readLittleEndian(data + 10) == 0;
+}
+
+uint32_t Frame::getContentSize() const {
+    return contentSize;
+}
+
+const uint8_t* Frame::decode(uint32_t length) {
+    if (length > contentSize) {
+        length = contentSize;
+    }
+
+    if (content == nullptr) {
+        content = new uint8_t[contentSize > 0 ? contentSize : 1];
+    }
+
+    while (decodedSize < length) {
+        if (frameSize - position < 4) {
+            Util::Exception::throwException(Util::Exception::OUT_OF_BOUNDS, "Lz4: Unexpected end of frame!");
+        }
+
+        auto blockSize = readLittleEndian(frame + position);
+        position += 4;
+        if (blockSize == 0) {
+            Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Lz4: Frame is shorter than its content size!");
+        }
+
+        auto uncompressed = (blockSize & UNCOMPRESSED_BLOCK) != 0;
+        blockSize &= ~UNCOMPRESSED_BLOCK;
+        if (frameSize - position < blockSize) {
+            Util::Exception::throwException(Util::Exception::OUT_OF_BOUNDS, "Lz4: Unexpected end of frame!");
+        }
+
+        if (uncompressed) {
+            if (contentSize - decodedSize < blockSize) {
+                Util::Exception::throwException(Util::Exception::OUT_OF_BOUNDS, "Lz4: Block exceeds content size!");
+            }
+
+            auto target = Util::Address<uint32_t>(content + decodedSize);
+            target.copyRange(Util::Address<uint32_t>(frame + position), blockSize);
+            decodedSize += blockSize;
+        } else {
+            decodeBlock(frame + position, blockSize);
+        }
+
+        position += blockSize + (blockChecksums ? 4 : 0);
+    }
+
+    return content;
+}
+
+void Frame::decodeBlock(const uint8_t *block, uint32_t blockSize) {
+    const auto *input = block;
+    const auto *inputEnd = block + blockSize;
+    auto *output = content + decodedSize;
+    auto *outputEnd = content + contentSize;
+
+    // A block consists of sequences: A token, literals and a match, which copies previously decoded bytes
+    while (input < inputEnd) {
+        auto token = *input++;
+
+        uint32_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            uint8_t value;
+            do {
+                if (input >= inputEnd) {
+                    Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Lz4: Invalid block!");
+                }
+
+                value = *input++;
+                literalLength += value;
+            } while (value == 255);
+        }
+
+        if (literalLength > static_cast<uint32_t>(inputEnd - input) || literalLength > static_cast<uint32_t>(outputEnd - output)) {
+            Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Lz4: Invalid block!");
+        }
+
+        auto target = Util::Address<uint32_t>(output);
+        target.copyRange(Util::Address<uint32_t>(input), literalLength);
+        input += literalLength;
+        output += literalLength;
+
+        // The last sequence of a block only consists of literals
+        if (input >= inputEnd) {
+            break;
+        }
+
+        if (inputEnd - input < 2) {
+            Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Lz4: Invalid block!");
+        }
+
+        uint32_t offset = input[0] | (input[1] << 8);
+        input += 2;
+        if (offset == 0 || offset > static_cast<uint32_t>(output - content)) {
+            Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Lz4: Invalid match offset!");
+        }
+
+        uint32_t matchLength = token & 0x0f;
+        if (matchLength == 15) {
+            uint8_t value;
+            do {
+                if (input >= inputEnd) {
+                    Util::Exception::throwException(Util::Exception::INVALID_ARGUMENT, "Lz4: Invalid block!");
+                }
+
+                value = *input++;
+                matchLength += value;
+            } while (value == 255);
+        }
+
+        matchLength += MIN_MATCH_LENGTH;
+        if (matchLength > static_cast<uint32_t>(outputEnd - output)) {
+            Util::Exception::throwException(Util::Exception::OUT_OF_BOUNDS, "Lz4: Block exceeds content size!");
+        }
+
+        // A match may overlap the bytes it produces (e.g. for runs), so it must be copied byte by byte
+        const auto *match = output - offset;
+        for (uint32_t i = 0; i < matchLength; i++) {
+            *output++ = *match++;
+        }
+    }
+
+    decodedSize = output - content;
+}
+
+uint32_t Frame::readLittleEndian(const uint8_t *data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+}
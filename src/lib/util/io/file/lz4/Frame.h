@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+ * Institute of Computer Science, Department Operating Systems
+ * Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef HHUOS_LZ4_FRAME_H
+#define HHUOS_LZ4_FRAME_H
+
+#include <cstdint>
+
+namespace Util::Io::Lz4 {
+
+/**
+ * Decoder for a single frame in the LZ4 frame format (as written by the 'lz4' command line tool).
+ * Blocks are decoded on demand into a buffer, which is allocated with the first decoded block,
+ * so that only the part of the content, which has actually been read, is decompressed.
+ * The frame is accessed in place, so it must remain mapped while it is used.
+ *
+ * Only frames with a content size (written with 'lz4 --content-size') and without a dictionary are supported.
+ * Checksums are skipped, but not verified.
+ */
+class Frame {
+
+public:
+    /**
+     * Constructor.
+     * The frame must be supported (see isSupported()).
+     *
+     * @param frame The frame, starting with its magic number
+     * @param frameSize The size of the frame in bytes
+     */
+    Frame(const uint8_t *frame, uint32_t frameSize);
+
+    /**
+     * Copy Constructor.
+     */
+    Frame(const Frame &other) = delete;
+
+    /**
+     * Assignment operator.
+     */
+    Frame &operator=(const Frame &other) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~Frame();
+
+    /**
+     * Check if data starts with an LZ4 frame, that can be decoded by this class.
+     *
+     * @param data The data to check
+     * @param size The size of the data in bytes
+     */
+    [[nodiscard]] static bool isSupported(const uint8_t *data, uint32_t size);
+
+    /**
+     * Get the size of the decompressed content.
+     */
+    [[nodiscard]] uint32_t getContentSize() const;
+
+    /**
+     * Decode blocks, until at least the first 'length' bytes of the content are available.
+     *
+     * @param length The amount of bytes, which must be available (limited to the content size)
+     *
+     * @return The decompressed content (valid up to 'length' bytes)
+     */
+    const uint8_t* decode(uint32_t length);
+
+    static const constexpr uint32_t MAGIC = 0x184d2204;
+
+private:
+
+    void decodeBlock(const uint8_t *block, uint32_t blockSize);
+
+    [[nodiscard]] static uint32_t readLittleEndian(const uint8_t *data);
+
+    const uint8_t *frame;
+    uint32_t frameSize;
+    uint32_t position = 0;
+    uint32_t contentSize = 0;
+    uint32_t decodedSize = 0;
+    bool blockChecksums = false;
+    uint8_t *content = nullptr;
+
+    static const constexpr uint8_t VERSION_MASK = 0xc0;
+    static const constexpr uint8_t VERSION = 0x40;
+    static const constexpr uint8_t BLOCK_CHECKSUM = 0x10;
+    static const constexpr uint8_t CONTENT_SIZE = 0x08;
+    static const constexpr uint8_t DICTIONARY_ID = 0x01;
+    static const constexpr uint32_t UNCOMPRESSED_BLOCK = 0x80000000;
+    static const constexpr uint32_t MIN_MATCH_LENGTH = 4;
+};
+
+}
+
+#endif
@@ -20,7 +20,9 @@
 
 namespace Util::Io::Tar {
 
-Archive::Archive(uint32_t address) {
+Archive::Archive(uint32_t address) : Archive(address, countHeaders(address)) {}
+
+Archive::Archive(uint32_t address, uint32_t headerCount) : fileIndex(headerCount * 2 + 1), directoryTree(headerCount + 1) {
     auto archiveAddress = Util::Address<uint32_t>(address);
 
     while (true) {
@@ -42,6 +44,36 @@ Archive::Archive(uint32_t address) {
             archiveAddress = archiveAddress.add(512);
         }
     }
+
+    directoryTree.put("", new Util::ArrayList<Util::String>());
+
+    for (auto *header : headers) {
+        if (header->typeFlag == LF_OLDNORMAL) {
+            fileIndex.put(header->filename, header);
+            addToDirectoryTree(header->filename);
+        }
+    }
+}
+
+Archive::~Archive() {
+    for (auto *children : directoryTree.values()) {
+        delete children;
+    }
+}
+
+uint32_t Archive::countHeaders(uint32_t address) {
+    uint32_t count = 0;
+    auto archiveAddress = Util::Address<uint32_t>(address);
+    while (true) {
+        auto *header = reinterpret_cast<Header*>(archiveAddress.get());
+        if (header->filename[0] == '\0') {
+            return count;
+        }
+
+        uint32_t size = calculateFileSize(*header);
+        archiveAddress = archiveAddress.add(((size + BLOCKSIZE - 1) / BLOCKSIZE + 1) * BLOCKSIZE);
+        count++;
+    }
 }
 
 uint32_t Archive::calculateFileSize(const Header &header) {
@@ -72,13 +104,49 @@ Util::Array<Archive::Header> Archive::getFileHeaders() {
 }
 
 uint8_t *Archive::getFile(const Util::String &path) {
-    for (auto *header : headers) {
-        if (path == header->filename) {
-            return reinterpret_cast<uint8_t*>(header) + BLOCKSIZE;
-        }
+    auto *header = getFileHeader(path);
+    if (header == nullptr) {
+        return nullptr;
     }
 
-    return nullptr;
+    return reinterpret_cast<uint8_t*>(const_cast<Header*>(header)) + BLOCKSIZE;
+}
+
+const Archive::Header* Archive::getFileHeader(const Util::String &path) const {
+    return fileIndex.containsKey(path) ? fileIndex.get(path) : nullptr;
+}
+
+bool Archive::isDirectory(const Util::String &path) const {
+    return directoryTree.containsKey(path);
+}
+
+Util::Array<Util::String> Archive::getChildren(const Util::String &path) const {
+    if (!directoryTree.containsKey(path)) {
+        return Util::Array<Util::String>(0);
+    }
+
+    return directoryTree.get(path)->toArray();
+}
+
+void Archive::addToDirectoryTree(const Util::String &path) {
+    // Every directory is added to its parent only once, when it is created, so no duplicate check is necessary
+    auto components = path.split("/");
+    Util::String parent;
+    for (uint32_t i = 0; i < components.length(); i++) {
+        const auto &name = components[i];
+        if (i == components.length() - 1) {
+            directoryTree.get(parent)->add(name);
+            break;
+        }
+
+        auto directory = parent.isEmpty() ? name : parent + "/" + name;
+        if (!directoryTree.containsKey(directory)) {
+            directoryTree.put(directory, new Util::ArrayList<Util::String>());
+            directoryTree.get(parent)->add(name);
+        }
+
+        parent = directory;
+    }
 }
 
 }
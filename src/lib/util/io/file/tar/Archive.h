@@ -22,9 +22,16 @@
 #include "lib/util/collection/Array.h"
 #include "lib/util/base/String.h"
 #include "lib/util/collection/ArrayList.h"
+#include "lib/util/collection/HashMap.h"
 
 namespace Util::Io::Tar {
 
+/**
+ * A tar archive in memory. All headers are parsed once, when the archive is constructed,
+ * and indexed by path. Directories are not stored explicitly in the archive, so a directory tree
+ * is derived from the file paths, which allows listing a directory without scanning the whole archive.
+ * Paths are relative to the root of the archive, without leading or trailing separators (the root is "").
+ */
 class Archive {
 
 public:
@@ -45,7 +52,7 @@ public:
 
     explicit Archive(uint32_t address);
 
-    ~Archive() = default;
+    ~Archive();
 
     Archive(const Archive &other) = delete;
 
@@ -66,6 +73,30 @@ public:
      */
     uint8_t* getFile(const Util::String &path);
 
+    /**
+     * Returns the header of the specified file within this archive.
+     *
+     * @param path The file's path.
+     * @return The header or nullptr if the file does not exist.
+     */
+    const Header* getFileHeader(const Util::String &path) const;
+
+    /**
+     * Checks if a directory exists in this archive (i.e. if it contains at least one file).
+     *
+     * @param path The directory's path.
+     * @return true, if the directory exists.
+     */
+    [[nodiscard]] bool isDirectory(const Util::String &path) const;
+
+    /**
+     * Returns the names of all files and directories directly inside a directory.
+     *
+     * @param path The directory's path.
+     * @return The names of the children (empty, if the directory does not exist).
+     */
+    [[nodiscard]] Util::Array<Util::String> getChildren(const Util::String &path) const;
+
     /**
      * Converts the size (base8) to the decimal system.
      *
@@ -76,10 +107,19 @@ public:
 
 private:
 
+    Archive(uint32_t address, uint32_t headerCount);
+
+    void addToDirectoryTree(const Util::String &path);
+
+    static uint32_t countHeaders(uint32_t address);
+
     uint32_t fileCount = 0;
     uint32_t totalSize = 0;
 
     Util::ArrayList<Header*> headers;
+    // Both maps are sized by the number of headers, so lookups take constant time on average
+    Util::HashMap<Util::String, Header*> fileIndex;
+    Util::HashMap<Util::String, Util::ArrayList<Util::String>*> directoryTree;
 
     static const constexpr uint8_t LF_NORMAL = 0;
     static const constexpr uint8_t LF_LINK = 1;
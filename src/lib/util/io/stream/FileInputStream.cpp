@@ -52,13 +52,7 @@ int16_t FileInputStream::read() {
 }
 
 int32_t FileInputStream::read(uint8_t *targetBuffer, uint32_t offset, uint32_t length) {
-    auto fileType = getFileType(fileDescriptor);
-    auto fileLength = getFileLength(fileDescriptor);
-
-    if (fileType == Io::File::REGULAR && pos >= fileLength) {
-        return -1;
-    }
-
+    // The kernel stops at the end of regular files, so a single system call is enough (0 bytes read means end of file)
     uint32_t count = readFile(fileDescriptor, targetBuffer + offset, pos, length);
     pos += count;
 
@@ -68,7 +68,7 @@ bool Ip4Route::hasNextHop() const {
     return nextHopValid;
 }
 
-bool Ip4Route::isValid() {
+bool Ip4Route::isValid() const {
     return !deviceIdentifier.isEmpty();
 }
 
@@ -76,7 +76,7 @@ public:
 
     [[nodiscard]] const Ip4Address& getNextHop() const;
 
-    [[nodiscard]] bool isValid();
+    [[nodiscard]] bool isValid() const;
 
 private:
 
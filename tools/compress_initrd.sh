@@ -0,0 +1,40 @@
+#!/bin/bash
+
+# Copyright (C) 2018-2023 Heinrich-Heine-Universitaet Duesseldorf,
+# Institute of Computer Science, Department Operating Systems
+# Burak Akguel, Christian Gesse, Fabian Ruhland, Filip Krakowski, Michael Schoettner
+#
+#
+# This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+# License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+# later version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+# warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>
+
+# Compress all files in a directory in place with LZ4, so that the tar archive driver decompresses them on demand.
+# Frames are written with their content size, which the kernel needs to report file lengths without decompressing.
+# Files, which do not become smaller, are kept uncompressed.
+
+readonly LZ4="${LZ4:-lz4}"
+
+if [ $# -ne 1 ]; then
+  printf "Usage: %s <directory>\\n" "$0"
+  exit 1
+fi
+
+find "$1" -type f | while read -r file; do
+  if ! "${LZ4}" -q -f -9 --content-size --no-frame-crc "${file}" "${file}.lz4"; then
+    exit 1
+  fi
+
+  if [ "$(stat -c %s "${file}.lz4")" -lt "$(stat -c %s "${file}")" ]; then
+    mv "${file}.lz4" "${file}"
+  else
+    rm "${file}.lz4"
+  fi
+done